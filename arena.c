@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "stats.h"
+
+// Set up an arena holding only the empty string at offset 0
+int initializeArena(StringArena *arena) {
+    arena->data = malloc(ARENA_INITIAL_CAPACITY);
+    if (arena->data == NULL) {
+        printf("Memory allocation failed!\n");
+        arena->used = 0;
+        arena->capacity = 0;
+        arena->garbage = 0;
+        return 0;
+    }
+    arena->capacity = ARENA_INITIAL_CAPACITY;
+    clearArena(arena);
+    return 1;
+}
+
+// Release the arena's storage
+void freeArena(StringArena *arena) {
+    free(arena->data);
+    arena->data = NULL;
+    arena->used = 0;
+    arena->capacity = 0;
+    arena->garbage = 0;
+}
+
+// Drop every string but keep the storage for reuse
+void clearArena(StringArena *arena) {
+    arena->data[0] = '\0';
+    arena->used = 1;
+    arena->garbage = 0;
+}
+
+// Make room for bytes more bytes, so the stores they cover cannot fail
+int reserveArena(StringArena *arena, size_t bytes) {
+    if (bytes > ARENA_MAX_SIZE - arena->used) {
+        printf("Error: String storage is full.\n");
+        return 0;
+    }
+    size_t needed = arena->used + bytes;
+    if (needed <= arena->capacity) {
+        return 1;
+    }
+    size_t new_capacity = arena->capacity ? arena->capacity : ARENA_INITIAL_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > ARENA_MAX_SIZE) {
+        new_capacity = ARENA_MAX_SIZE;
+    }
+    char *data = realloc(arena->data, new_capacity);
+    if (data == NULL) {
+        printf("Memory reallocation failed!\n");
+        return 0;
+    }
+    arena->data = data;
+    arena->capacity = new_capacity;
+    STATS_REALLOC(new_capacity);
+    return 1;
+}
+
+// Copy text (with its NUL) into the arena and return its handle. Empty text
+// shares the string at offset 0.
+int arenaStore(StringArena *arena, const char *text, unsigned int *offset, unsigned char *length) {
+    size_t len = strlen(text);
+    if (len > 255) {
+        printf("Error: Text is too long to store.\n");
+        return 0;
+    }
+    if (len == 0) {
+        *offset = 0;
+        *length = 0;
+        return 1;
+    }
+    if (!reserveArena(arena, len + 1)) {
+        return 0;
+    }
+    memcpy(arena->data + arena->used, text, len + 1);
+    *offset = (unsigned int)arena->used;
+    *length = (unsigned char)len;
+    arena->used += len + 1;
+    return 1;
+}
+
+// Account for a string that is no longer referenced
+void arenaRelease(StringArena *arena, unsigned char length) {
+    if (length > 0) {
+        arena->garbage += (size_t)length + 1;
+    }
+}
+
+// Worth compacting once released strings make up half of the arena
+int arenaNeedsCompaction(const StringArena *arena) {
+    return arena->garbage >= ARENA_COMPACT_MIN && arena->garbage * 2 > arena->used;
+}
@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Offsets are 32-bit, so one arena holds at most this many bytes
+#define ARENA_MAX_SIZE 0xffffffffu
+#define ARENA_INITIAL_CAPACITY 256
+#define ARENA_COMPACT_MIN 4096      // Garbage bytes tolerated before compaction is considered
+
+// Append-only pool of NUL-terminated strings addressed by byte offset.
+// Offset 0 always holds the empty string, so a zeroed handle reads as "".
+typedef struct {
+    char *data;
+    size_t used;
+    size_t capacity;
+    size_t garbage;             // Bytes of released strings still in data
+} StringArena;
+
+// Function declarations for the string arena
+int initializeArena(StringArena *arena);
+void freeArena(StringArena *arena);
+void clearArena(StringArena *arena);
+int reserveArena(StringArena *arena, size_t bytes);
+int arenaStore(StringArena *arena, const char *text, unsigned int *offset, unsigned char *length);
+void arenaRelease(StringArena *arena, unsigned char length);
+int arenaNeedsCompaction(const StringArena *arena);
+
+// Text at offset (valid until the next store, which may move the pool)
+#define arenaText(arena, offset) ((const char *)(arena)->data + (offset))
+
+#endif // ARENA_H
@@ -0,0 +1,446 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "contact.h"
+#include "file.h"
+#include "populate.h"
+
+// Benchmark suite: builds a seeded synthetic roster at each size and times
+// every public operation, reporting throughput and p50/p99 latency.
+// Usage: ./addressbook_bench [--json] [--seed N] [sizes...]
+// The report goes to stdout (CSV, or JSON with --json); progress goes to
+// stderr and the library's own console output is discarded.
+
+#define BENCH_MAX_SIZES 16
+#define BENCH_KEYS 1024             // Contacts sampled up front as query keys
+#define BENCH_MIN_SAMPLES 3
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_BUDGET_US 500000.0    // Stop sampling an operation after this much time
+#define BENCH_RESULTS 10            // Result buffer size for the top-k searches
+#define BENCH_FILE "bench_roster.csv"
+
+static const int bench_default_sizes[] = {10000, 100000, 1000000};
+
+typedef struct {
+    AddressBook *book;
+    AddressBook *loaded;        // Scratch book the load operation fills
+    Contact *keys;              // Live contacts picked at random
+    int key_count;
+    int slots[BENCH_RESULTS];
+    int distances[BENCH_RESULTS];
+    int deleted;                // Contacts removed so far by the delete operation
+    long checksum;              // Folds in every result so no call is optimized away
+} BenchContext;
+
+// One timed operation; run() performs sample i and returns a value for the checksum
+typedef struct {
+    const char *name;
+    long (*run)(BenchContext *context, int i);
+    int per_contact;            // Throughput counts contacts rather than calls
+    int scan;                   // Also timed with the scan cache
+} BenchOperation;
+
+typedef struct {
+    int size;
+    const char *layout;
+    const char *operation;
+    int samples;
+    double throughput;
+    const char *unit;
+    double p50_us;
+    double p99_us;
+} BenchResult;
+
+// Monotonic clock in microseconds
+static double nowUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+// qsort comparator for latencies
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Key contact for sample i
+static const Contact *benchKey(const BenchContext *context, int i) {
+    return &context->keys[i % context->key_count];
+}
+
+// Save: write the whole book as CSV (no fsync or backup, so this is the
+// serializer rather than the disk)
+static long benchSave(BenchContext *context, int i) {
+    (void)i;
+    FILE *file = fopen(BENCH_FILE, "w");
+    if (file == NULL) {
+        return 0;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    int ok = writeContactsCSV(context->book, NULL, context->book->count, file);
+    return fclose(file) == 0 && ok;
+}
+
+// Load: parse the saved CSV into the scratch book
+static long benchLoad(BenchContext *context, int i) {
+    (void)i;
+    return loadContactsFromFile(context->loaded, BENCH_FILE) ? countContacts(context->loaded) : 0;
+}
+
+static long benchRollIndex(BenchContext *context, int i) {
+    return findContactByRoll(context->book, benchKey(context, i)->roll_no);
+}
+
+static long benchBinaryRoll(BenchContext *context, int i) {
+    return binarySearchByRoll(context->book, benchKey(context, i)->roll_no);
+}
+
+// Count and collect the first results of a 1000-wide roll number range
+static long benchRollRange(BenchContext *context, int i) {
+    int low = benchKey(context, i)->roll_no;
+    return findContactsByRollRange(context->book, low, low + 999, context->slots, BENCH_RESULTS);
+}
+
+static long benchBinaryName(BenchContext *context, int i) {
+    return binarySearchByName(context->book, benchKey(context, i)->name);
+}
+
+static long benchPhoneHash(BenchContext *context, int i) {
+    return findContactByPhone(context->book, benchKey(context, i)->phone);
+}
+
+static long benchDepartmentIndex(BenchContext *context, int i) {
+    const int *slots;
+    return findContactsByDepartment(context->book, benchKey(context, i)->department, &slots);
+}
+
+// Phone autocomplete on the first six digits of a key
+static long benchPhonePrefix(BenchContext *context, int i) {
+    char prefix[7];
+    memcpy(prefix, benchKey(context, i)->phone, 6);
+    prefix[6] = '\0';
+    return findContactsByPhonePrefix(context->book, prefix, context->slots, BENCH_RESULTS);
+}
+
+// Name autocomplete on the first three letters of a key
+static long benchNamePrefix(BenchContext *context, int i) {
+    char prefix[4];
+    memcpy(prefix, benchKey(context, i)->name, 3);
+    prefix[3] = '\0';
+    return findContactsByNamePrefix(context->book, prefix, context->slots, BENCH_RESULTS);
+}
+
+static long benchFuzzyName(BenchContext *context, int i) {
+    const char *name = benchKey(context, i)->name;
+    return fuzzySearchByName(context->book, name, fuzzyDistanceBound(name),
+                             context->slots, context->distances, BENCH_RESULTS);
+}
+
+static long benchSoundex(BenchContext *context, int i) {
+    return findContactsBySound(context->book, benchKey(context, i)->name, context->slots, BENCH_RESULTS);
+}
+
+static long benchLinearName(BenchContext *context, int i) {
+    return linearSearchByName(context->book, benchKey(context, i)->name);
+}
+
+static long benchLinearPhone(BenchContext *context, int i) {
+    return linearSearchByPhone(context->book, benchKey(context, i)->phone);
+}
+
+static long benchLinearRoll(BenchContext *context, int i) {
+    return linearSearchByRoll(context->book, benchKey(context, i)->roll_no);
+}
+
+static long benchLinearDepartment(BenchContext *context, int i) {
+    return linearSearchByDepartment(context->book, benchKey(context, i)->department);
+}
+
+static long benchSortName(BenchContext *context, int i) {
+    (void)i;
+    sortContactsByName(context->book);
+    return context->book->name_order[0];
+}
+
+static long benchSortRoll(BenchContext *context, int i) {
+    (void)i;
+    sortContactsByRoll(context->book);
+    return context->book->roll_order[0];
+}
+
+static long benchList(BenchContext *context, int i) {
+    (void)i;
+    listContacts(context->book);
+    return countContacts(context->book);
+}
+
+// Edit: rewrite a key's email, alternating between a changed and the
+// original spelling on successive passes over the keys
+static long benchEdit(BenchContext *context, int i) {
+    Contact updated = *benchKey(context, i);
+    int slot = findContactByRoll(context->book, updated.roll_no);
+    if (slot < 0) {
+        return 0;
+    }
+    if ((i / context->key_count) % 2 == 0) {
+        updated.email[0] = updated.email[0] == 'x' ? 'y' : 'x';
+    }
+    return replaceContact(context->book, slot, &updated);
+}
+
+// Delete: remove contacts from the end of the book, one per sample
+static long benchDelete(BenchContext *context, int i) {
+    (void)i;
+    AddressBook *book = context->book;
+    int slot = book->count - 1 - context->deleted;
+    while (slot >= 0 && !isLiveSlot(book, slot)) {
+        slot--;
+    }
+    context->deleted = book->count - slot;
+    return slot >= 0 && removeContact(book, slot);
+}
+
+// Read-only operations, in report order
+static const BenchOperation bench_queries[] = {
+    {"find_by_roll", benchRollIndex, 0, 0},
+    {"binary_search_roll", benchBinaryRoll, 0, 0},
+    {"roll_range", benchRollRange, 0, 0},
+    {"binary_search_name", benchBinaryName, 0, 0},
+    {"find_by_phone", benchPhoneHash, 0, 0},
+    {"find_by_department", benchDepartmentIndex, 0, 0},
+    {"phone_prefix", benchPhonePrefix, 0, 0},
+    {"name_prefix", benchNamePrefix, 0, 0},
+    {"fuzzy_name", benchFuzzyName, 0, 0},
+    {"soundex_name", benchSoundex, 0, 0},
+    {"linear_search_name", benchLinearName, 0, 1},
+    {"linear_search_phone", benchLinearPhone, 0, 1},
+    {"linear_search_roll", benchLinearRoll, 0, 1},
+    {"linear_search_department", benchLinearDepartment, 0, 1},
+    {"sort_by_name", benchSortName, 1, 0},
+    {"sort_by_roll", benchSortRoll, 1, 0},
+    {"list", benchList, 1, 0}
+};
+
+#define BENCH_QUERY_COUNT ((int)(sizeof(bench_queries) / sizeof(bench_queries[0])))
+
+static const BenchOperation bench_save = {"save", benchSave, 1, 0};
+static const BenchOperation bench_load = {"load", benchLoad, 1, 0};
+static const BenchOperation bench_edit = {"edit", benchEdit, 0, 0};
+static const BenchOperation bench_delete = {"delete", benchDelete, 0, 0};
+
+// Turn per-sample latencies into a result row
+static void summarize(BenchResult *result, double *latencies, int samples, double total_us, int work) {
+    qsort(latencies, samples, sizeof(double), compareDoubles);
+    result->samples = samples;
+    result->p50_us = latencies[samples / 2];
+    result->p99_us = latencies[(samples * 99) / 100 < samples ? (samples * 99) / 100 : samples - 1];
+    result->throughput = total_us > 0 ? (double)work * samples * 1000000.0 / total_us : 0;
+}
+
+// Sample an operation until it has BENCH_MAX_SAMPLES timings or has used its
+// time budget (but at least BENCH_MIN_SAMPLES)
+static void measure(BenchContext *context, const BenchOperation *operation, int size,
+                    const char *layout, BenchResult *result) {
+    double latencies[BENCH_MAX_SAMPLES];
+    double total = 0;
+    int samples = 0;
+    while (samples < BENCH_MAX_SAMPLES && (samples < BENCH_MIN_SAMPLES || total < BENCH_BUDGET_US)) {
+        if (operation->run == benchLoad) {
+            clearAddressBook(context->loaded);
+        }
+        double start = nowUs();
+        context->checksum += operation->run(context, samples);
+        double elapsed = nowUs() - start;
+        latencies[samples++] = elapsed;
+        total += elapsed;
+    }
+    result->size = size;
+    result->layout = layout;
+    result->operation = operation->name;
+    result->unit = operation->per_contact ? "contacts/s" : "ops/s";
+    summarize(result, latencies, samples, total, operation->per_contact ? size : 1);
+}
+
+// Pick BENCH_KEYS live contacts at random as query keys
+static int pickKeys(BenchContext *context, unsigned int seed) {
+    AddressBook *book = context->book;
+    context->key_count = book->count < BENCH_KEYS ? book->count : BENCH_KEYS;
+    context->keys = malloc(context->key_count * sizeof(Contact));
+    if (context->keys == NULL) {
+        return 0;
+    }
+    unsigned long long state = seed ^ 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < context->key_count; i++) {
+        int slot;
+        do {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            slot = (int)((state >> 33) % (unsigned long long)book->count);
+        } while (!isLiveSlot(book, slot));
+        getContact(book, slot, &context->keys[i]);
+    }
+    return 1;
+}
+
+// Run every operation at one size; returns the number of results written
+static int benchSize(int size, unsigned int seed, BenchResult *results) {
+    AddressBook book, loaded;
+    initializeAddressBook(&book);
+    initializeAddressBook(&loaded);
+    BenchContext context = {&book, &loaded, NULL, 0, {0}, {0}, 0, 0};
+    int produced = 0;
+
+    fprintf(stderr, "Benchmarking %d contacts (seed %u)...\n", size, seed);
+    double start = nowUs();
+    if (!populateGeneratedContacts(&book, size, seed) || !pickKeys(&context, seed)) {
+        fprintf(stderr, "Error: Could not build a roster of %d contacts.\n", size);
+        freeAddressBook(&book);
+        freeAddressBook(&loaded);
+        return -1;
+    }
+    double elapsed = nowUs() - start;
+    BenchResult *generate = &results[produced++];
+    generate->size = size;
+    generate->layout = "rows";
+    generate->operation = "generate";
+    generate->unit = "contacts/s";
+    summarize(generate, &elapsed, 1, elapsed, size);
+
+    measure(&context, &bench_save, size, "rows", &results[produced++]);
+    measure(&context, &bench_load, size, "rows", &results[produced++]);
+    remove(BENCH_FILE);
+    freeAddressBook(&loaded);
+    initializeAddressBook(&loaded);
+
+    for (int q = 0; q < BENCH_QUERY_COUNT; q++) {
+        measure(&context, &bench_queries[q], size, "rows", &results[produced++]);
+    }
+    if (setScanLayout(&book, STORAGE_SCAN_CACHE)) {
+        for (int q = 0; q < BENCH_QUERY_COUNT; q++) {
+            if (bench_queries[q].scan) {
+                measure(&context, &bench_queries[q], size, "cache", &results[produced++]);
+            }
+        }
+        setScanLayout(&book, STORAGE_ROWS);
+    } else {
+        fprintf(stderr, "Warning: Could not build the scan cache; skipping its scans.\n");
+    }
+
+    measure(&context, &bench_edit, size, "rows", &results[produced++]);
+    measure(&context, &bench_delete, size, "rows", &results[produced++]);
+
+    fprintf(stderr, "  done (checksum %ld)\n", context.checksum);
+    free(context.keys);
+    freeAddressBook(&book);
+    freeAddressBook(&loaded);
+    return produced;
+}
+
+// Write the results as CSV
+static void reportCSV(FILE *out, const BenchResult *results, int count) {
+    fprintf(out, "size,layout,operation,samples,throughput,unit,p50_us,p99_us\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(out, "%d,%s,%s,%d,%.1f,%s,%.3f,%.3f\n", r->size, r->layout, r->operation,
+                r->samples, r->throughput, r->unit, r->p50_us, r->p99_us);
+    }
+}
+
+// Write the results as a JSON array of objects
+static void reportJSON(FILE *out, const BenchResult *results, int count) {
+    fprintf(out, "[\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(out, "  {\"size\": %d, \"layout\": \"%s\", \"operation\": \"%s\", \"samples\": %d, "
+                "\"throughput\": %.1f, \"unit\": \"%s\", \"p50_us\": %.3f, \"p99_us\": %.3f}%s\n",
+                r->size, r->layout, r->operation, r->samples, r->throughput, r->unit,
+                r->p50_us, r->p99_us, i + 1 < count ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+// Point stdout at /dev/null so the library's messages and listings stay out
+// of the report; returns a stream on the original stdout
+static FILE *separateReport(void) {
+    fflush(stdout);
+    int report = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (report < 0 || null_fd < 0 || dup2(null_fd, STDOUT_FILENO) < 0) {
+        return NULL;
+    }
+    close(null_fd);
+    return fdopen(report, "w");
+}
+
+// Print usage to stderr
+static void printBenchUsage(void) {
+    fprintf(stderr, "Usage: addressbook_bench [--json] [--seed N] [sizes...]\n");
+    fprintf(stderr, "Default sizes: 10000 100000 1000000 (up to %d)\n", ROSTER_MAX_SIZE);
+}
+
+// Run the benchmark suite
+int main(int argc, char *argv[]) {
+    int sizes[BENCH_MAX_SIZES];
+    int size_count = 0;
+    int json = 0;
+    unsigned int seed = ROSTER_DEFAULT_SEED;
+
+    for (int i = 1; i < argc; i++) {
+        char *end;
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)strtoul(argv[++i], &end, 10);
+            if (*end != '\0') {
+                printBenchUsage();
+                return 2;
+            }
+        } else {
+            long size = strtol(argv[i], &end, 10);
+            if (*end != '\0' || size <= 0 || size > ROSTER_MAX_SIZE || size_count == BENCH_MAX_SIZES) {
+                printBenchUsage();
+                return 2;
+            }
+            sizes[size_count++] = (int)size;
+        }
+    }
+    if (size_count == 0) {
+        size_count = (int)(sizeof(bench_default_sizes) / sizeof(bench_default_sizes[0]));
+        memcpy(sizes, bench_default_sizes, sizeof(bench_default_sizes));
+    }
+
+    FILE *out = separateReport();
+    int capacity = size_count * (BENCH_QUERY_COUNT * 2 + 5);
+    BenchResult *results = malloc(capacity * sizeof(BenchResult));
+    if (out == NULL || results == NULL) {
+        fprintf(stderr, "Error: Could not set up the benchmark.\n");
+        free(results);
+        return 1;
+    }
+
+    int count = 0;
+    int status = 0;
+    for (int s = 0; s < size_count; s++) {
+        int produced = benchSize(sizes[s], seed, results + count);
+        if (produced < 0) {
+            status = 1;
+            break;
+        }
+        count += produced;
+    }
+
+    if (json) {
+        reportJSON(out, results, count);
+    } else {
+        reportCSV(out, results, count);
+    }
+    fclose(out);
+    free(results);
+    return status;
+}
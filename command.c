@@ -0,0 +1,339 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define fdopen _fdopen
+#define close _close
+#else
+#include <unistd.h>
+#endif
+#include "command.h"
+#include "file.h"
+#include "populate.h"
+#include "query.h"
+#include "server.h"
+
+// Print the subcommand synopsis
+static void printUsage(void) {
+    fprintf(stderr, "Usage: addressbook [options] <command> [arguments]\n");
+    fprintf(stderr, "Commands:\n");
+    fprintf(stderr, "  find --roll <number>     Contact with this roll number\n");
+    fprintf(stderr, "  find --dept <name>       Contacts in a department\n");
+    fprintf(stderr, "  find --name <name>       Contacts with this exact name\n");
+    fprintf(stderr, "  find --phone <number>    Contact with this phone number\n");
+    fprintf(stderr, "  find --query <query>     Contacts matching a multi-field query, e.g.\n");
+    fprintf(stderr, "                           'dept = \"Computer Science\" and roll between 1000 and 2000'\n");
+    fprintf(stderr, "  import <file.csv>        Add the contacts of a CSV file and save\n");
+    fprintf(stderr, "  export [file.csv]        Write every contact as CSV (stdout by default)\n");
+    fprintf(stderr, "  generate <count> [seed]  Write count synthetic students as CSV (same seed, same roster)\n");
+    fprintf(stderr, "  serve [socket]           Answer requests on a Unix socket (default %s)\n",
+            SERVER_SOCKET_PATH);
+    fprintf(stderr, "Results are CSV on stdout; messages go to stderr. Exit status is\n");
+    fprintf(stderr, "0 on success, 1 when find matches nothing, 2 on bad usage, 3 on errors.\n");
+}
+
+// Is name one of the subcommands?
+int isCommand(const char *name) {
+    return strcmp(name, "find") == 0 || strcmp(name, "import") == 0 ||
+           strcmp(name, "export") == 0 || strcmp(name, "generate") == 0 ||
+           strcmp(name, "serve") == 0;
+}
+
+// Point stdout at stderr so the status messages printed while loading and
+// saving stay out of the results; returns a stream on the original stdout
+static FILE *separateOutput(void) {
+    fflush(stdout);
+    int fd = dup(fileno(stdout));
+    if (fd == -1) {
+        return stdout;
+    }
+    FILE *out = fdopen(fd, "w");
+    if (out == NULL) {
+        close(fd);
+        return stdout;
+    }
+    dup2(fileno(stderr), fileno(stdout));
+    return out;
+}
+
+// Slots of the contacts whose field ("roll", "dept", "name" or "phone",
+// case-insensitive) matches value, in a malloc'd array the caller frees.
+// Returns the number of matches or FIND_BAD_FIELD, FIND_BAD_VALUE or FIND_FAILED.
+int findMatches(const AddressBook *book, const char *field, const char *value, int **slots) {
+    *slots = NULL;
+    if (strcasecmp(field, "roll") == 0 || strcasecmp(field, "phone") == 0) {
+        int slot;
+        if (strcasecmp(field, "roll") == 0) {
+            char *end;
+            long roll_no = strtol(value, &end, 10);
+            if (*value == '\0' || *end != '\0' || roll_no <= 0 || roll_no > 2147483647L) {
+                return FIND_BAD_VALUE;
+            }
+            slot = findContactByRoll(book, (int)roll_no);
+        } else {
+            slot = findContactByPhone(book, value);
+        }
+        if (slot == -1) {
+            return 0;
+        }
+        *slots = malloc(sizeof(int));
+        if (*slots == NULL) {
+            return FIND_FAILED;
+        }
+        (*slots)[0] = slot;
+        return 1;
+    }
+    if (strcasecmp(field, "dept") == 0) {
+        const int *members;
+        int count = findContactsByDepartment(book, value, &members);
+        if (count == 0) {
+            return 0;
+        }
+        *slots = malloc(count * sizeof(int));
+        if (*slots == NULL) {
+            return FIND_FAILED;
+        }
+        memcpy(*slots, members, count * sizeof(int));
+        return count;
+    }
+    if (strcasecmp(field, "name") == 0) {
+        // Exact names are the prefix matches of full length
+        int total = findContactsByNamePrefix(book, value, NULL, 0);
+        if (total == 0) {
+            return 0;
+        }
+        *slots = malloc(total * sizeof(int));
+        if (*slots == NULL) {
+            return FIND_FAILED;
+        }
+        total = findContactsByNamePrefix(book, value, *slots, total);
+        int count = 0;
+        for (int i = 0; i < total; i++) {
+            if (strcasecmp(contactName(book, (*slots)[i]), value) == 0) {
+                (*slots)[count++] = (*slots)[i];
+            }
+        }
+        return count;
+    }
+    return FIND_BAD_FIELD;
+}
+
+// find --query <query>: stream the matches straight from the query iterator
+static int queryCommand(const AddressBook *book, const char *text, FILE *out) {
+    Query query;
+    if (!parseQuery(text, &query)) {
+        return COMMAND_USAGE;
+    }
+    QueryIterator iterator;
+    startQuery(&iterator, book, &query);
+    
+    fprintf(out, "Name,Phone,Email,Roll_No,Department\n");
+    int found = 0;
+    int slot;
+    while ((slot = nextQueryResult(&iterator)) != -1) {
+        Contact contact;
+        getContact(book, slot, &contact);
+        writeContactCSV(&contact, out);
+        found++;
+    }
+    if (ferror(out)) {
+        fprintf(stderr, "Error: Unable to write results.\n");
+        return COMMAND_FAILED;
+    }
+    return found > 0 ? COMMAND_OK : COMMAND_NOT_FOUND;
+}
+
+// find --roll|--dept|--name|--phone <value>, or --query <query>
+static int findCommand(const AddressBook *book, int argc, char *argv[], FILE *out) {
+    if (argc != 3 || strncmp(argv[1], "--", 2) != 0) {
+        printUsage();
+        return COMMAND_USAGE;
+    }
+    if (strcmp(argv[1], "--query") == 0) {
+        return queryCommand(book, argv[2], out);
+    }
+    int *slots;
+    int count = findMatches(book, argv[1] + 2, argv[2], &slots);
+    switch (count) {
+        case FIND_BAD_FIELD:
+            fprintf(stderr, "Error: Unknown find field '%s'.\n", argv[1]);
+            printUsage();
+            return COMMAND_USAGE;
+        case FIND_BAD_VALUE:
+            fprintf(stderr, "Error: Invalid value '%s' for %s.\n", argv[2], argv[1]);
+            return COMMAND_USAGE;
+        case FIND_FAILED:
+            fprintf(stderr, "Memory allocation failed!\n");
+            return COMMAND_FAILED;
+    }
+    
+    int status = COMMAND_OK;
+    if (!writeContactsCSV(book, slots, count, out)) {
+        fprintf(stderr, "Error: Unable to write results.\n");
+        status = COMMAND_FAILED;
+    } else if (count == 0) {
+        status = COMMAND_NOT_FOUND;
+    }
+    free(slots);
+    return status;
+}
+
+// import <file.csv>: append every contact whose roll number (and phone, with
+// --unique-phones) is not taken yet, then save the book
+static int importCommand(AddressBook *book, int argc, char *argv[], FILE *out) {
+    if (argc != 2) {
+        printUsage();
+        return COMMAND_USAGE;
+    }
+    if (!fileExists(argv[1])) {
+        fprintf(stderr, "Error: File %s not found.\n", argv[1]);
+        return COMMAND_FAILED;
+    }
+    
+    AddressBook incoming;
+    initializeAddressBook(&incoming);
+    int rejected = 0; // Lines of the file the loader could not use
+    if (!loadContactsFromFileParallel(&incoming, argv[1], 0, &rejected)) {
+        freeAddressBook(&incoming);
+        return COMMAND_FAILED;
+    }
+    
+    Contact *batch = malloc((incoming.count > 0 ? incoming.count : 1) * sizeof(Contact));
+    unsigned char *status = malloc(incoming.count > 0 ? incoming.count : 1);
+    if (batch == NULL || status == NULL) {
+        fprintf(stderr, "Memory allocation failed!\n");
+        free(batch);
+        free(status);
+        freeAddressBook(&incoming);
+        return COMMAND_FAILED;
+    }
+    
+    // With --unique-phones, drop phones already in the book or earlier in the file
+    int candidates = 0;
+    for (int i = 0; i < incoming.count; i++) {
+        Contact *contact = &batch[candidates];
+        getContact(&incoming, i, contact);
+        if (book->reject_duplicate_phones &&
+            (findContactByPhone(book, contact->phone) != -1 ||
+             findContactByPhone(&incoming, contact->phone) < i)) {
+            fprintf(stderr, "Warning: Phone number of roll number %d already exists, skipping.\n",
+                    contact->roll_no);
+            continue;
+        }
+        candidates++;
+    }
+    
+    int imported = insertContacts(book, batch, candidates, status);
+    for (int i = 0; imported >= 0 && i < candidates; i++) {
+        if (status[i] == INSERT_DUPLICATE_ROLL) {
+            fprintf(stderr, "Warning: Roll number %d already exists, skipping.\n",
+                    batch[i].roll_no);
+        }
+    }
+    int skipped = rejected + incoming.count - imported;
+    free(batch);
+    free(status);
+    freeAddressBook(&incoming);
+    if (imported < 0 || !refreshSortedIndexes(book)) {
+        return COMMAND_FAILED;
+    }
+    
+    if (imported > 0 && !saveAddressBook(book, CSV_FILENAME)) {
+        return COMMAND_FAILED;
+    }
+    fprintf(out, "Imported,Skipped\n%d,%d\n", imported, skipped);
+    return COMMAND_OK;
+}
+
+// export [file.csv]: every contact as CSV, to stdout or a file
+static int exportCommand(const AddressBook *book, int argc, char *argv[], FILE *out) {
+    if (argc > 2) {
+        printUsage();
+        return COMMAND_USAGE;
+    }
+    if (argc == 1) {
+        return writeContactsCSV(book, NULL, book->count, out) ? COMMAND_OK : COMMAND_FAILED;
+    }
+    
+    FILE *file = fopen(argv[1], "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open file %s for writing.\n", argv[1]);
+        return COMMAND_FAILED;
+    }
+    int ok = writeContactsCSV(book, NULL, book->count, file);
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Error: Unable to write file %s.\n", argv[1]);
+        return COMMAND_FAILED;
+    }
+    fprintf(stderr, "Successfully exported %d contact(s) to %s\n", countContacts(book), argv[1]);
+    return COMMAND_OK;
+}
+
+// generate <count> [seed]: stream a synthetic roster as CSV without touching
+// the saved book
+static int generateCommand(int argc, char *argv[], FILE *out) {
+    char *end;
+    long count = argc >= 2 ? strtol(argv[1], &end, 10) : 0;
+    if (argc < 2 || argc > 3 || *end != '\0' || count <= 0 || count > ROSTER_MAX_SIZE) {
+        printUsage();
+        return COMMAND_USAGE;
+    }
+    unsigned long seed = ROSTER_DEFAULT_SEED;
+    if (argc == 3) {
+        seed = strtoul(argv[2], &end, 10);
+        if (*end != '\0') {
+            printUsage();
+            return COMMAND_USAGE;
+        }
+    }
+    
+    RosterGenerator generator;
+    initializeRoster(&generator, (unsigned int)seed);
+    fprintf(out, "Name,Phone,Email,Roll_No,Department\n");
+    for (long i = 0; i < count; i++) {
+        Contact contact;
+        generateStudent(&generator, &contact);
+        writeContactCSV(&contact, out);
+    }
+    return ferror(out) ? COMMAND_FAILED : COMMAND_OK;
+}
+
+// serve [socket]: keep the loaded book in memory and answer requests until
+// interrupted (see server.c for the protocol)
+static int serveCommand(AddressBook *book, int argc, char *argv[]) {
+    if (argc > 2) {
+        printUsage();
+        return COMMAND_USAGE;
+    }
+    return runServer(book, argc == 2 ? argv[1] : SERVER_SOCKET_PATH) ? COMMAND_OK : COMMAND_FAILED;
+}
+
+// Run one subcommand (argv[0]) against the saved book without the menu.
+// Returns the process exit status.
+int runCommand(AddressBook *book, int argc, char *argv[]) {
+    FILE *out = separateOutput();
+    int status;
+    if (strcmp(argv[0], "generate") == 0) {
+        status = generateCommand(argc, argv, out);
+    } else if (!loadAddressBook(book, CSV_FILENAME)) {
+        status = COMMAND_FAILED;
+    } else if (strcmp(argv[0], "find") == 0) {
+        status = findCommand(book, argc, argv, out);
+    } else if (strcmp(argv[0], "import") == 0) {
+        status = importCommand(book, argc, argv, out);
+    } else if (strcmp(argv[0], "serve") == 0) {
+        status = serveCommand(book, argc, argv);
+    } else {
+        status = exportCommand(book, argc, argv, out);
+    }
+    if (fflush(out) != 0 && status == COMMAND_OK) {
+        status = COMMAND_FAILED;
+    }
+    return status;
+}
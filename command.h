@@ -0,0 +1,22 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include "contact.h"
+
+// Exit statuses of a command-line subcommand
+#define COMMAND_OK 0
+#define COMMAND_NOT_FOUND 1     // A find matched nothing
+#define COMMAND_USAGE 2
+#define COMMAND_FAILED 3
+
+// Errors returned by findMatches instead of a match count
+#define FIND_BAD_FIELD -1
+#define FIND_BAD_VALUE -2
+#define FIND_FAILED -3
+
+// Function declarations for command-line subcommands
+int isCommand(const char *name);
+int findMatches(const AddressBook *book, const char *field, const char *value, int **slots);
+int runCommand(AddressBook *book, int argc, char *argv[]);
+
+#endif // COMMAND_H
@@ -1,18 +1,61 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <ctype.h>
 #include "contact.h"
+#include "query.h"
+#include "render.h"
+#include "stats.h"
+#include "validate.h"
+
+static int reserveSortedIndexes(AddressBook *book, int entries);
+static int rebuildColumns(AddressBook *book);
+static int rebuildDepartmentIndex(AddressBook *book);
+static int findPhoneMatch(const AddressBook *book, const char *digits, int exact, int exclude_slot);
+static void orderInsert(AddressBook *book, SortField field, int *order, int n, int slot);
+static void loadRollFences(AddressBook *book);
+static void freeColumns(ContactColumns *columns);
+
+// department_text entry of a department no stored contact names yet
+#define DEPARTMENT_TEXT_NONE 0xffffffffu
 
 // Initialize the address book
 void initializeAddressBook(AddressBook *book) {
-    book->contacts = malloc(INITIAL_CAPACITY * sizeof(Contact));
-    if (book->contacts == NULL) {
+    book->contacts = malloc(INITIAL_CAPACITY * sizeof(ContactRecord));
+    if (book->contacts == NULL || !initializeArena(&book->strings)) {
         printf("Memory allocation failed!\n");
         exit(1);
     }
     book->count = 0;
     book->capacity = INITIAL_CAPACITY;
+    book->roll_index = NULL;
+    book->roll_index_size = 0;
+    book->name_order = NULL;
+    book->roll_order = NULL;
+    book->phone_order = NULL;
+    book->sorted_count = 0;
+    book->order_count = 0;
+    book->order_capacity = 0;
+    initializeFenceIndex(&book->roll_fences);
+    book->free_slots = NULL;
+    book->free_count = 0;
+    book->free_capacity = 0;
+    book->reject_duplicate_phones = 0;
+    book->on_change = NULL;
+    book->change_context = NULL;
+    book->layout = STORAGE_ROWS;
+    memset(&book->columns, 0, sizeof(book->columns));
+    initializeDepartments(&book->departments);
+    book->department_ids = NULL;
+    book->department_capacity = 0;
+    book->department_text = NULL;
+    book->department_text_capacity = 0;
+    initializeTrigrams(&book->name_trigrams);
+    initializePhonetics(&book->name_sounds);
+    if (!rebuildRollIndex(book)) {
+        exit(1);
+    }
 }
 
 // Free memory allocated for address book
@@ -21,298 +64,2334 @@ void freeAddressBook(AddressBook *book) {
         free(book->contacts);
         book->contacts = NULL;
     }
+    if (book->roll_index) {
+        free(book->roll_index);
+        book->roll_index = NULL;
+    }
+    free(book->name_order);
+    free(book->roll_order);
+    free(book->phone_order);
+    book->name_order = NULL;
+    book->roll_order = NULL;
+    book->phone_order = NULL;
+    freeFenceIndex(&book->roll_fences);
+    freeColumns(&book->columns);
+    book->layout = STORAGE_ROWS;
+    freeDepartments(&book->departments);
+    free(book->department_ids);
+    book->department_ids = NULL;
+    book->department_capacity = 0;
+    free(book->department_text);
+    book->department_text = NULL;
+    book->department_text_capacity = 0;
+    freeArena(&book->strings);
+    freeTrigrams(&book->name_trigrams);
+    freePhonetics(&book->name_sounds);
+    free(book->free_slots);
+    book->free_slots = NULL;
+    book->free_count = 0;
+    book->free_capacity = 0;
     book->count = 0;
     book->capacity = 0;
+    book->roll_index_size = 0;
+    book->sorted_count = 0;
+    book->order_count = 0;
+    book->order_capacity = 0;
+}
+
+// Report a change to the book's listener, if one is attached
+static void notifyChange(const AddressBook *book, ChangeType type, int old_roll_no, const Contact *contact) {
+    if (book->on_change != NULL) {
+        book->on_change(book->change_context, type, old_roll_no, contact);
+    }
+}
+
+// Remove every contact but keep the allocated storage for reuse
+void clearAddressBook(AddressBook *book) {
+    book->count = 0;
+    book->sorted_count = 0;
+    book->order_count = 0;
+    book->roll_fences.count = 0;
+    book->free_count = 0;
+    for (int i = 0; i < book->roll_index_size; i++) {
+        book->roll_index[i].slot = -1;
+    }
+    clearDepartments(&book->departments);
+    clearArena(&book->strings);
+    for (int i = 0; i < book->department_text_capacity; i++) {
+        book->department_text[i] = DEPARTMENT_TEXT_NONE;
+    }
+    freeTrigrams(&book->name_trigrams);
+    freePhonetics(&book->name_sounds);
+    notifyChange(book, CHANGE_CLEAR, 0, NULL);
+}
+
+// Grow the contacts array to hold at least entries contacts
+static int reserveContacts(AddressBook *book, int entries) {
+    if (entries <= book->capacity) {
+        return 1;
+    }
+    int new_capacity = book->capacity ? book->capacity * 2 : INITIAL_CAPACITY;
+    while (new_capacity < entries) {
+        new_capacity *= 2;
+    }
+    ContactRecord *temp = realloc(book->contacts, new_capacity * sizeof(ContactRecord));
+    if (temp == NULL) {
+        printf("Memory reallocation failed!\n");
+        return 0;
+    }
+    book->contacts = temp;
+    book->capacity = new_capacity;
+    STATS_REALLOC(new_capacity * sizeof(ContactRecord));
+    return 1;
 }
 
 // Resize address book if needed
 static int resizeAddressBook(AddressBook *book) {
-    if (book->count >= book->capacity) {
-        int new_capacity = book->capacity * 2;
-        Contact *temp = realloc(book->contacts, new_capacity * sizeof(Contact));
-        if (temp == NULL) {
-            printf("Memory reallocation failed!\n");
-            return 0;
-        }
-        book->contacts = temp;
-        book->capacity = new_capacity;
+    return reserveContacts(book, book->count + 1);
+}
+
+// Release every column of the scan cache
+static void freeColumns(ContactColumns *columns) {
+    free(columns->name);
+    free(columns->phone);
+    free(columns->roll_no);
+    memset(columns, 0, sizeof(*columns));
+}
+
+// Grow every column to hold at least entries contacts
+static int reserveColumns(AddressBook *book, int entries) {
+    ContactColumns *columns = &book->columns;
+    if (entries <= columns->capacity) {
+        return 1;
+    }
+    int new_capacity = columns->capacity ? columns->capacity : INITIAL_CAPACITY;
+    while (new_capacity < entries) {
+        new_capacity *= 2;
+    }
+
+    void *name = realloc(columns->name, new_capacity * sizeof(*columns->name));
+    if (name != NULL) {
+        columns->name = name;
+    }
+    void *phone = realloc(columns->phone, new_capacity * sizeof(*columns->phone));
+    if (phone != NULL) {
+        columns->phone = phone;
+    }
+    void *roll_no = realloc(columns->roll_no, new_capacity * sizeof(*columns->roll_no));
+    if (roll_no != NULL) {
+        columns->roll_no = roll_no;
+    }
+    if (name == NULL || phone == NULL || roll_no == NULL) {
+        printf("Memory reallocation failed!\n");
+        return 0;
     }
+    columns->capacity = new_capacity;
+    STATS_REALLOC(new_capacity * (sizeof(*columns->name) + sizeof(*columns->phone) +
+                                  sizeof(*columns->roll_no)));
     return 1;
 }
 
-// Validate name input
-int validateName(const char *name) {
-    if (strlen(name) == 0 || strlen(name) >= MAX_NAME_LEN) {
+// Copy the contact in slot into the columns
+static void storeColumns(AddressBook *book, int slot) {
+    const ContactRecord *record = &book->contacts[slot];
+    ContactColumns *columns = &book->columns;
+    memcpy(columns->name[slot], contactName(book, slot), record->name_len + 1);
+    memcpy(columns->phone[slot], contactPhone(book, slot), record->phone_len + 1);
+    columns->roll_no[slot] = record->roll_no;
+}
+
+// Regenerate the columns from the contacts array (no-op without the scan cache)
+static int rebuildColumns(AddressBook *book) {
+    if (book->layout != STORAGE_SCAN_CACHE) {
+        return 1;
+    }
+    if (!reserveColumns(book, book->count)) {
         return 0;
     }
-    // Check if name contains only letters and spaces
-    for (int i = 0; name[i]; i++) {
-        if (!isalpha(name[i]) && name[i] != ' ') {
-            return 0;
-        }
+    for (int i = 0; i < book->count; i++) {
+        storeColumns(book, i);
     }
     return 1;
 }
 
-// Validate phone number
-int validatePhone(const char *phone) {
-    if (strlen(phone) < 10 || strlen(phone) >= MAX_PHONE_LEN) {
+// Turn the scan cache on or off, building or dropping the columns
+int setScanLayout(AddressBook *book, ScanLayout layout) {
+    if (layout == book->layout) {
+        return 1;
+    }
+    book->layout = layout;
+    if (layout == STORAGE_ROWS) {
+        freeColumns(&book->columns);
+        return 1;
+    }
+    if (!rebuildColumns(book)) {
+        freeColumns(&book->columns);
+        book->layout = STORAGE_ROWS;
         return 0;
     }
-    // Check if phone contains only digits, +, -, (, ), and spaces
-    for (int i = 0; phone[i]; i++) {
-        if (!isdigit(phone[i]) && phone[i] != '+' && phone[i] != '-' && 
-            phone[i] != '(' && phone[i] != ')' && phone[i] != ' ') {
-            return 0;
-        }
+    return 1;
+}
+
+// Grow department_ids to hold at least entries slots
+static int reserveDepartmentIds(AddressBook *book, int entries) {
+    if (entries <= book->department_capacity) {
+        return 1;
+    }
+    int new_capacity = book->department_capacity ? book->department_capacity : INITIAL_CAPACITY;
+    while (new_capacity < entries) {
+        new_capacity *= 2;
     }
+    int *ids = realloc(book->department_ids, new_capacity * sizeof(int));
+    if (ids == NULL) {
+        printf("Memory reallocation failed!\n");
+        return 0;
+    }
+    book->department_ids = ids;
+    book->department_capacity = new_capacity;
+    STATS_REALLOC(new_capacity * sizeof(int));
     return 1;
 }
 
-// Validate email
-int validateEmail(const char *email) {
-    if (strlen(email) == 0 || strlen(email) >= MAX_EMAIL_LEN) {
+// Grow department_text to cover entries departments (new entries are unset)
+static int reserveDepartmentText(AddressBook *book, int entries) {
+    if (entries <= book->department_text_capacity) {
+        return 1;
+    }
+    int new_capacity = book->department_text_capacity ? book->department_text_capacity : INITIAL_CAPACITY;
+    while (new_capacity < entries) {
+        new_capacity *= 2;
+    }
+    unsigned int *text = realloc(book->department_text, new_capacity * sizeof(unsigned int));
+    if (text == NULL) {
+        printf("Memory reallocation failed!\n");
         return 0;
     }
-    // Simple email validation - must contain @ and .
-    char *at_pos = strchr(email, '@');
-    char *dot_pos = strrchr(email, '.');
-    if (at_pos == NULL || dot_pos == NULL || at_pos > dot_pos) {
+    for (int i = book->department_text_capacity; i < new_capacity; i++) {
+        text[i] = DEPARTMENT_TEXT_NONE;
+    }
+    book->department_text = text;
+    book->department_text_capacity = new_capacity;
+    STATS_REALLOC(new_capacity * sizeof(unsigned int));
+    return 1;
+}
+
+// Arena bytes needed to store the text of contact
+static size_t contactTextSize(const Contact *contact) {
+    return strlen(contact->name) + strlen(contact->phone) + strlen(contact->email) +
+           strlen(contact->department) + 4;
+}
+
+// Point record at department id's shared name if text spells it the same way,
+// otherwise store a private copy (the first copy becomes the shared one)
+static int storeDepartmentText(AddressBook *book, int id, const char *text, ContactRecord *record) {
+    unsigned int shared = book->department_text[id];
+    if (shared != DEPARTMENT_TEXT_NONE && strcmp(arenaText(&book->strings, shared), text) == 0) {
+        record->department = shared;
+        record->department_len = (unsigned char)strlen(text);
+        return 1;
+    }
+    if (!arenaStore(&book->strings, text, &record->department, &record->department_len)) {
         return 0;
     }
+    if (shared == DEPARTMENT_TEXT_NONE) {
+        book->department_text[id] = record->department;
+    }
     return 1;
 }
 
-// Validate roll number (must be unique)
-int validateRollNo(int roll_no, const AddressBook *book, int exclude_index) {
-    if (roll_no <= 0) {
+// Copy contact's text into slot's record; the department id of slot must be
+// set and the arena space reserved (see contactTextSize)
+static int storeContactText(AddressBook *book, int slot, const Contact *contact) {
+    ContactRecord *record = &book->contacts[slot];
+    StringArena *strings = &book->strings;
+    if (!arenaStore(strings, contact->name, &record->name, &record->name_len) ||
+        !arenaStore(strings, contact->phone, &record->phone, &record->phone_len) ||
+        !arenaStore(strings, contact->email, &record->email, &record->email_len) ||
+        !storeDepartmentText(book, book->department_ids[slot], contact->department, record)) {
+        return 0;
+    }
+    record->roll_no = contact->roll_no;
+    return 1;
+}
+
+// Release the text of the record in slot (its department id must still be current)
+static void releaseContactText(AddressBook *book, int slot) {
+    const ContactRecord *record = &book->contacts[slot];
+    arenaRelease(&book->strings, record->name_len);
+    arenaRelease(&book->strings, record->phone_len);
+    arenaRelease(&book->strings, record->email_len);
+    if (record->department != book->department_text[book->department_ids[slot]]) {
+        arenaRelease(&book->strings, record->department_len);
+    }
+}
+
+// Store contact in slot and add slot to its department's posting list
+static int storeContact(AddressBook *book, int slot, const Contact *contact) {
+    int id = internDepartment(&book->departments, contact->department);
+    if (id == -1 || !reserveDepartmentText(book, book->departments.count) ||
+        !addDepartmentMember(&book->departments, id, slot)) {
+        return 0;
+    }
+    book->department_ids[slot] = id;
+    return storeContactText(book, slot, contact);
+}
+
+// Copy the live contacts' text into a fresh arena, dropping released strings
+// and sharing each department's name again. No slot moves.
+int compactStrings(AddressBook *book) {
+    size_t needed = 0;
+    for (int i = 0; i < book->count; i++) {
+        const ContactRecord *record = &book->contacts[i];
+        needed += (size_t)record->name_len + record->phone_len + record->email_len +
+                  record->department_len + 4;
+    }
+    StringArena fresh;
+    if (!initializeArena(&fresh) || !reserveArena(&fresh, needed) ||
+        !reserveDepartmentText(book, book->departments.count)) {
+        freeArena(&fresh);
         return 0;
     }
+    for (int i = 0; i < book->department_text_capacity; i++) {
+        book->department_text[i] = DEPARTMENT_TEXT_NONE;
+    }
+    
+    StringArena old = book->strings;
+    book->strings = fresh;
     for (int i = 0; i < book->count; i++) {
-        if (i != exclude_index && book->contacts[i].roll_no == roll_no) {
-            return 0; // Roll number already exists
+        if (!isLiveSlot(book, i)) {
+            continue;
         }
+        ContactRecord *record = &book->contacts[i];
+        arenaStore(&book->strings, arenaText(&old, record->name), &record->name, &record->name_len);
+        arenaStore(&book->strings, arenaText(&old, record->phone), &record->phone, &record->phone_len);
+        arenaStore(&book->strings, arenaText(&old, record->email), &record->email, &record->email_len);
+        storeDepartmentText(book, book->department_ids[i], arenaText(&old, record->department), record);
     }
+    freeArena(&old); // Every store above fit in the reserved space
     return 1;
 }
 
-// Add a new contact
-int addContact(AddressBook *book) {
-    if (!resizeAddressBook(book)) {
+// Intern the department of the contact in slot and add slot to its posting list
+static int indexDepartment(AddressBook *book, int slot) {
+    int id = internDepartment(&book->departments, contactDepartment(book, slot));
+    if (id == -1 || !addDepartmentMember(&book->departments, id, slot)) {
         return 0;
     }
+    book->department_ids[slot] = id;
+    return 1;
+}
 
-    Contact new_contact;
-    char buffer[256];
-    
-    printf("\n=== Add New Contact ===\n");
-    
-    // Get name
-    do {
-        printf("Enter name: ");
-        fgets(buffer, sizeof(buffer), stdin);
-        buffer[strcspn(buffer, "\n")] = 0; // Remove newline
-        if (!validateName(buffer)) {
-            printf("Invalid name! Name should contain only letters and spaces (1-49 characters).\n");
+// Rebuild the department dictionary and posting lists from the contacts array
+static int indexDepartments(AddressBook *book) {
+    clearDepartments(&book->departments);
+    if (!reserveDepartmentIds(book, book->count)) {
+        return 0;
+    }
+    for (int i = 0; i < book->count; i++) {
+        if (!isLiveSlot(book, i)) {
+            book->department_ids[i] = -1;
+        } else if (!indexDepartment(book, i)) {
+            return 0;
         }
-    } while (!validateName(buffer));
-    strcpy(new_contact.name, buffer);
-    
-    // Get phone
-    do {
-        printf("Enter phone number: ");
-        fgets(buffer, sizeof(buffer), stdin);
-        buffer[strcspn(buffer, "\n")] = 0;
-        if (!validatePhone(buffer)) {
-            printf("Invalid phone number! Must be 10-14 characters with digits and optional +, -, (), spaces.\n");
+    }
+    return 1;
+}
+
+// Rebuild the department index, then the arena so department names are
+// shared under the new ids
+static int rebuildDepartmentIndex(AddressBook *book) {
+    return indexDepartments(book) && compactStrings(book);
+}
+
+// Arena bytes a stored string of length occupies (empty text is shared)
+static size_t storedTextSize(unsigned char length) {
+    return length > 0 ? (size_t)length + 1 : 0;
+}
+
+// Take over a restored arena without copying it: each department shares the
+// lowest offset among its members (the copy stored first), and the bytes no
+// record references are counted as garbage
+static int adoptStrings(AddressBook *book) {
+    if (!reserveDepartmentText(book, book->departments.count)) {
+        return 0;
+    }
+    for (int i = 0; i < book->department_text_capacity; i++) {
+        book->department_text[i] = DEPARTMENT_TEXT_NONE;
+    }
+    for (int i = 0; i < book->count; i++) {
+        if (isLiveSlot(book, i)) {
+            unsigned int *shared = &book->department_text[book->department_ids[i]];
+            if (book->contacts[i].department < *shared) {
+                *shared = book->contacts[i].department;
+            }
         }
-    } while (!validatePhone(buffer));
-    strcpy(new_contact.phone, buffer);
+    }
     
-    // Get email
-    do {
-        printf("Enter email: ");
-        fgets(buffer, sizeof(buffer), stdin);
-        buffer[strcspn(buffer, "\n")] = 0;
-        if (!validateEmail(buffer)) {
-            printf("Invalid email! Must contain @ and . in correct positions.\n");
+    size_t referenced = 0;
+    for (int i = 0; i < book->count; i++) {
+        if (!isLiveSlot(book, i)) {
+            continue;
         }
-    } while (!validateEmail(buffer));
-    strcpy(new_contact.email, buffer);
-    
-    // Get roll number
-    do {
-        printf("Enter roll number: ");
-        scanf("%d", &new_contact.roll_no);
-        getchar(); // Consume newline
-        if (!validateRollNo(new_contact.roll_no, book, -1)) {
-            printf("Invalid roll number! Must be positive and unique.\n");
+        const ContactRecord *record = &book->contacts[i];
+        referenced += storedTextSize(record->name_len) + storedTextSize(record->phone_len) +
+                      storedTextSize(record->email_len);
+        if (record->department != book->department_text[book->department_ids[i]]) {
+            referenced += storedTextSize(record->department_len);
         }
-    } while (!validateRollNo(new_contact.roll_no, book, -1));
-    
-    // Get department
-    do {
-        printf("Enter department: ");
-        fgets(buffer, sizeof(buffer), stdin);
-        buffer[strcspn(buffer, "\n")] = 0;
-        if (strlen(buffer) == 0 || strlen(buffer) >= MAX_DEPT_LEN) {
-            printf("Invalid department! Must be 1-49 characters.\n");
+    }
+    for (int id = 0; id < book->departments.count; id++) {
+        unsigned int shared = book->department_text[id];
+        if (shared != DEPARTMENT_TEXT_NONE && shared != 0) {
+            referenced += strlen(arenaText(&book->strings, shared)) + 1;
         }
-    } while (strlen(buffer) == 0 || strlen(buffer) >= MAX_DEPT_LEN);
-    strcpy(new_contact.department, buffer);
-    
-    // Add contact to address book
-    book->contacts[book->count] = new_contact;
-    book->count++;
-    
-    printf("Contact added successfully!\n");
+    }
+    size_t stored = book->strings.used - 1;
+    book->strings.garbage = referenced < stored ? stored - referenced : 0;
+    return 1;
+}
+
+// Build the name trigram and/or phonetic index from the contacts array
+static int buildNameIndexes(AddressBook *book, int trigrams, int phonetics) {
+    if (trigrams) {
+        freeTrigrams(&book->name_trigrams);
+    }
+    if (phonetics) {
+        freePhonetics(&book->name_sounds);
+    }
+    if (book->count == 0 || (!trigrams && !phonetics)) {
+        return 1;
+    }
+    const char **names = malloc(book->count * sizeof(const char *));
+    if (names == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    for (int i = 0; i < book->count; i++) {
+        names[i] = contactName(book, i);
+    }
+    int ok = (!trigrams || bulkAddTrigrams(&book->name_trigrams, names, 0, book->count)) &&
+             (!phonetics || bulkAddPhonetics(&book->name_sounds, names, 0, book->count));
+    free(names);
+    return ok;
+}
+
+// Rebuild the name trigram and phonetic indexes from the contacts array
+static int rebuildNameIndexes(AddressBook *book) {
+    return buildNameIndexes(book, 1, 1);
+}
+
+// Slots of every contact in a department (case-insensitive), in slot order.
+// Returns the number of members; *slots stays valid until the next change.
+int findContactsByDepartment(const AddressBook *book, const char *department, const int **slots) {
+    STATS_START(start);
+    int id = findDepartment(&book->departments, department);
+    int found = 0;
+    *slots = NULL;
+    if (id != -1) {
+        *slots = book->departments.entries[id].members.slots;
+        found = book->departments.entries[id].members.count;
+    }
+    STATS_STOP(STAT_FIND_DEPARTMENT, start);
+    return found;
+}
+
+// Name of the contact in slot, read from whichever layout is active
+static const char *slotName(const AddressBook *book, int slot) {
+    return book->layout == STORAGE_SCAN_CACHE ? book->columns.name[slot] : contactName(book, slot);
+}
+
+// Phone of the contact in slot, read from whichever layout is active
+static const char *slotPhone(const AddressBook *book, int slot) {
+    return book->layout == STORAGE_SCAN_CACHE ? book->columns.phone[slot] : contactPhone(book, slot);
+}
+
+// Roll number of the contact in slot, read from whichever layout is active
+static int slotRollNo(const AddressBook *book, int slot) {
+    return book->layout == STORAGE_SCAN_CACHE ? book->columns.roll_no[slot] : book->contacts[slot].roll_no;
+}
+
+// Hash a roll number to its home bucket (Fibonacci hashing)
+static unsigned int hashRollNo(int roll_no, int size) {
+    unsigned int h = (unsigned int)roll_no * 2654435769u;
+    return (h ^ (h >> 16)) & (unsigned int)(size - 1);
+}
+
+// Insert or overwrite the bucket for roll_no (table must have a free bucket)
+static void rollIndexPut(AddressBook *book, int roll_no, int slot) {
+    unsigned int mask = (unsigned int)book->roll_index_size - 1;
+    unsigned int i = hashRollNo(roll_no, book->roll_index_size);
+    while (book->roll_index[i].slot != -1 && book->roll_index[i].roll_no != roll_no) {
+        i = (i + 1) & mask;
+    }
+    book->roll_index[i].roll_no = roll_no;
+    book->roll_index[i].slot = slot;
+}
+
+// Remove roll_no from the index, shifting later entries back to close the gap
+static void rollIndexRemove(AddressBook *book, int roll_no) {
+    RollIndexEntry *table = book->roll_index;
+    unsigned int mask = (unsigned int)book->roll_index_size - 1;
+    unsigned int hole = hashRollNo(roll_no, book->roll_index_size);
+    while (table[hole].slot != -1 && table[hole].roll_no != roll_no) {
+        hole = (hole + 1) & mask;
+    }
+    if (table[hole].slot == -1) {
+        return;
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    unsigned int j = hole;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (table[j].slot == -1) {
+            break;
+        }
+        unsigned int home = hashRollNo(table[j].roll_no, book->roll_index_size);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            table[hole] = table[j];
+            hole = j;
+        }
+    }
+    table[hole].slot = -1;
+}
+
+// Grow the index so that it stays at most half full after adding entries
+static int reserveRollIndex(AddressBook *book, int entries) {
+    if (book->roll_index != NULL && entries * 2 <= book->roll_index_size) {
+        return 1;
+    }
+
+    int new_size = ROLL_INDEX_INITIAL_SIZE;
+    while (new_size < entries * 2) {
+        new_size *= 2;
+    }
+
+    RollIndexEntry *table = malloc(new_size * sizeof(RollIndexEntry));
+    if (table == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    for (int i = 0; i < new_size; i++) {
+        table[i].slot = -1;
+    }
+
+    RollIndexEntry *old_table = book->roll_index;
+    int old_size = book->roll_index_size;
+    book->roll_index = table;
+    book->roll_index_size = new_size;
+    STATS_REALLOC(new_size * sizeof(RollIndexEntry));
+    for (int i = 0; i < old_size; i++) {
+        if (old_table[i].slot != -1) {
+            rollIndexPut(book, old_table[i].roll_no, old_table[i].slot);
+        }
+    }
+    free(old_table);
+    return 1;
+}
+
+// Rebuild the roll number index from scratch (after contacts are reordered)
+int rebuildRollIndex(AddressBook *book) {
+    if (!reserveRollIndex(book, book->count)) {
+        return 0;
+    }
+    for (int i = 0; i < book->roll_index_size; i++) {
+        book->roll_index[i].slot = -1;
+    }
+    for (int i = 0; i < book->count; i++) {
+        if (isLiveSlot(book, i)) {
+            rollIndexPut(book, book->contacts[i].roll_no, i);
+        }
+    }
     return 1;
 }
 
-// Display a single contact
-void displayContact(const Contact *contact, int index) {
-    printf("%-4d %-20s %-15s %-30s %-8d %-15s\n", 
-           index + 1, contact->name, contact->phone, 
-           contact->email, contact->roll_no, contact->department);
+// Slot holding roll_no, or -1 if absent (the untimed lookup the public
+// searches and the validators share)
+static int rollIndexFind(const AddressBook *book, int roll_no) {
+    if (book->roll_index == NULL) {
+        for (int i = 0; i < book->count; i++) {
+            if (book->contacts[i].roll_no == roll_no) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    unsigned int mask = (unsigned int)book->roll_index_size - 1;
+    unsigned int i = hashRollNo(roll_no, book->roll_index_size);
+    while (book->roll_index[i].slot != -1) {
+        if (book->roll_index[i].roll_no == roll_no) {
+            return book->roll_index[i].slot;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// Look up the slot holding roll_no in O(1), or -1 if absent
+int findContactByRoll(const AddressBook *book, int roll_no) {
+    STATS_START(start);
+    int slot = rollIndexFind(book, roll_no);
+    STATS_STOP(STAT_FIND_ROLL, start);
+    return slot;
+}
+
+// Does slot hold a contact (rather than a deleted one awaiting reuse)?
+int isLiveSlot(const AddressBook *book, int slot) {
+    return book->contacts[slot].roll_no > 0;
+}
+
+// Number of contacts in the book, not counting deleted slots
+int countContacts(const AddressBook *book) {
+    return book->count - book->free_count;
+}
+
+// Name of the contact in slot (valid until the book next changes)
+const char *contactName(const AddressBook *book, int slot) {
+    return arenaText(&book->strings, book->contacts[slot].name);
+}
+
+// Phone of the contact in slot (valid until the book next changes)
+const char *contactPhone(const AddressBook *book, int slot) {
+    return arenaText(&book->strings, book->contacts[slot].phone);
+}
+
+// Email of the contact in slot (valid until the book next changes)
+const char *contactEmail(const AddressBook *book, int slot) {
+    return arenaText(&book->strings, book->contacts[slot].email);
+}
+
+// Department of the contact in slot, as spelled by that contact
+const char *contactDepartment(const AddressBook *book, int slot) {
+    return arenaText(&book->strings, book->contacts[slot].department);
+}
+
+// Copy the full text of the contact in slot into contact
+void getContact(const AddressBook *book, int slot, Contact *contact) {
+    const ContactRecord *record = &book->contacts[slot];
+    memset(contact, 0, sizeof(*contact));
+    memcpy(contact->name, contactName(book, slot), record->name_len);
+    memcpy(contact->phone, contactPhone(book, slot), record->phone_len);
+    memcpy(contact->email, contactEmail(book, slot), record->email_len);
+    memcpy(contact->department, contactDepartment(book, slot), record->department_len);
+    contact->roll_no = record->roll_no;
+}
+
+// Add an already validated contact, reusing the most recently deleted slot
+// if there is one, and register it in every index
+int appendContact(AddressBook *book, const Contact *contact) {
+    int reuse = book->free_count > 0;
+    int slot = reuse ? book->free_slots[book->free_count - 1] : book->count;
+    if (!reuse && !resizeAddressBook(book)) {
+        return 0;
+    }
+    if (!reserveRollIndex(book, countContacts(book) + 1)) {
+        return 0;
+    }
+    if (book->layout == STORAGE_SCAN_CACHE && !reserveColumns(book, book->count + 1)) {
+        return 0;
+    }
+    if (!reserveDepartmentIds(book, book->count + 1) ||
+        !reserveArena(&book->strings, contactTextSize(contact))) {
+        return 0;
+    }
+    if (!storeContact(book, slot, contact) ||
+        !addTrigrams(&book->name_trigrams, contact->name, slot) ||
+        !addPhonetics(&book->name_sounds, contact->name, slot)) {
+        return 0;
+    }
+    if (book->layout == STORAGE_SCAN_CACHE) {
+        storeColumns(book, slot);
+    }
+    rollIndexPut(book, contact->roll_no, slot);
+    if (reuse) {
+        book->free_count--;
+    } else {
+        book->count++;
+    }
+    
+    // A reused slot below sorted_count is covered by the orders
+    if (slot < book->sorted_count) {
+        orderInsert(book, SORT_BY_NAME, book->name_order, book->order_count, slot);
+        orderInsert(book, SORT_BY_ROLL, book->roll_order, book->order_count, slot);
+        orderInsert(book, SORT_BY_PHONE, book->phone_order, book->order_count, slot);
+        book->order_count++;
+    }
+    notifyChange(book, CHANGE_ADD, contact->roll_no, contact);
+    return 1;
+}
+
+// Grow the contacts array and every per-slot index to hold entries contacts
+int reserveAddressBook(AddressBook *book, int entries) {
+    return reserveContacts(book, entries) && reserveRollIndex(book, entries) &&
+           reserveDepartmentIds(book, entries) &&
+           (book->layout != STORAGE_SCAN_CACHE || reserveColumns(book, entries));
+}
+
+// Add roll_no to a temporary open-addressing set of size (a power of two,
+// 0 marks an empty bucket). Returns 0 if it was already there.
+static int rollSetAdd(int *set, int size, int roll_no) {
+    unsigned int mask = (unsigned int)size - 1;
+    unsigned int i = hashRollNo(roll_no, size);
+    while (set[i] != 0) {
+        if (set[i] == roll_no) {
+            return 0;
+        }
+        i = (i + 1) & mask;
+    }
+    set[i] = roll_no;
+    return 1;
+}
+
+// Insert a batch of records. Name, phone and email are validated in one
+// pass and roll numbers are checked against the book and, through a
+// temporary hash set, against earlier records of the batch; status[i]
+// receives the InsertStatus of record i. Storage and indexes grow once for
+// the accepted records. Returns how many were inserted, or -1 if memory ran out.
+int insertContacts(AddressBook *book, const Contact *contacts, int count, unsigned char *status) {
+    if (count <= 0) {
+        return 0;
+    }
+    int set_size = ROLL_INDEX_INITIAL_SIZE;
+    while (set_size < count * 2) {
+        set_size *= 2;
+    }
+    unsigned long long *valid = malloc(VALIDATE_BITMAP_WORDS(count) * sizeof(unsigned long long));
+    int *roll_set = calloc(set_size, sizeof(int));
+    if (valid == NULL || roll_set == NULL) {
+        printf("Memory allocation failed!\n");
+        free(valid);
+        free(roll_set);
+        return -1;
+    }
+    
+    validateContactBatch(contacts, count, valid);
+    int accepted = 0;
+    for (int i = 0; i < count; i++) {
+        int roll_no = contacts[i].roll_no;
+        if (!(valid[i / 64] & (1ULL << (i % 64))) || roll_no <= 0) {
+            status[i] = INSERT_INVALID;
+        } else if (rollIndexFind(book, roll_no) != -1 || !rollSetAdd(roll_set, set_size, roll_no)) {
+            status[i] = INSERT_DUPLICATE_ROLL;
+        } else {
+            status[i] = INSERT_OK;
+            accepted++;
+        }
+    }
+    free(valid);
+    free(roll_set);
+    if (accepted == 0) {
+        return 0;
+    }
+    
+    // Deleted slots are refilled one by one; the rest of the batch is
+    // appended as one contiguous range and indexed in bulk
+    int next = 0;
+    int refilled = 0;
+    for (; next < count && book->free_count > 0; next++) {
+        if (status[next] != INSERT_OK) {
+            continue;
+        }
+        if (!appendContact(book, &contacts[next])) {
+            return -1;
+        }
+        refilled++;
+    }
+    accepted -= refilled;
+    if (accepted == 0) {
+        return refilled;
+    }
+    int first = book->count;
+    size_t text_size = 0;
+    for (int i = next; i < count; i++) {
+        if (status[i] == INSERT_OK) {
+            text_size += contactTextSize(&contacts[i]);
+        }
+    }
+    const char **names = malloc(accepted * sizeof(const char *));
+    if (names == NULL) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    if (!reserveAddressBook(book, first + accepted) || !reserveArena(&book->strings, text_size)) {
+        free(names);
+        return -1;
+    }
+    for (int i = next; i < count; i++) {
+        if (status[i] != INSERT_OK) {
+            continue;
+        }
+        int slot = book->count;
+        if (!storeContact(book, slot, &contacts[i])) {
+            free(names);
+            return -1;
+        }
+        if (book->layout == STORAGE_SCAN_CACHE) {
+            storeColumns(book, slot);
+        }
+        rollIndexPut(book, contacts[i].roll_no, slot);
+        names[slot - first] = contacts[i].name;
+        book->count++;
+    }
+    int ok = bulkAddTrigrams(&book->name_trigrams, names, first, accepted) &&
+             bulkAddPhonetics(&book->name_sounds, names, first, accepted);
+    free(names);
+    if (!ok) {
+        return -1;
+    }
+    for (int i = next; i < count; i++) {
+        if (status[i] == INSERT_OK) {
+            notifyChange(book, CHANGE_ADD, contacts[i].roll_no, &contacts[i]);
+        }
+    }
+    return refilled + accepted;
+}
+
+// Does every handle of record point at a NUL-terminated string that fits its
+// Contact field?
+static int recordFitsStrings(const ContactRecord *record, const char *strings, size_t size) {
+    const unsigned int offsets[4] = {record->name, record->phone, record->email, record->department};
+    const unsigned char lengths[4] = {record->name_len, record->phone_len, record->email_len,
+                                      record->department_len};
+    const int limits[4] = {MAX_NAME_LEN, MAX_PHONE_LEN, MAX_EMAIL_LEN, MAX_DEPT_LEN};
+    for (int f = 0; f < 4; f++) {
+        if (lengths[f] >= limits[f] || (size_t)offsets[f] + lengths[f] >= size ||
+            strings[offsets[f] + lengths[f]] != '\0') {
+            return 0;
+        }
+    }
+    return record->roll_no > 0;
+}
+
+// Are the stored roll index and orders consistent with the n restored
+// contacts? Every slot they name must lie in [0, n) and hold a live contact
+// (with the roll number the index claims), the index must hold every
+// contact once, and roll_order must ascend.
+// Checked before any of them is adopted, since a checksum only proves they
+// were read back as written.
+static int storedIndexesValid(const ContactRecord *contacts, int n,
+                              const RollIndexEntry *roll_index, int roll_index_size,
+                              const int *name_order, const int *roll_order,
+                              const int *phone_order, int sorted_count) {
+    for (int i = 0; i < n; i++) {
+        if (contacts[i].roll_no <= 0) {
+            return 0; // Snapshots hold compact books, without deleted slots
+        }
+    }
+    int indexed = 0;
+    for (int i = 0; roll_index != NULL && i < roll_index_size; i++) {
+        int slot = roll_index[i].slot;
+        if (slot != -1 && (slot < 0 || slot >= n || contacts[slot].roll_no != roll_index[i].roll_no)) {
+            return 0;
+        }
+        indexed += slot != -1;
+    }
+    if (roll_index != NULL && indexed != n) {
+        return 0;
+    }
+    const int *orders[3] = {name_order, roll_order, phone_order};
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; orders[f] != NULL && i < sorted_count; i++) {
+            if (orders[f][i] < 0 || orders[f][i] >= n) {
+                return 0;
+            }
+        }
+    }
+    for (int i = 1; roll_order != NULL && i < sorted_count; i++) {
+        if (contacts[roll_order[i - 1]].roll_no >= contacts[roll_order[i]].roll_no) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Replace the book's contents with prebuilt contacts, their string arena and
+// indexes (e.g. a snapshot). Returns 0 if they are inconsistent.
+int restoreAddressBook(AddressBook *book, const ContactRecord *contacts, int count,
+                       const char *strings, size_t strings_size,
+                       const RollIndexEntry *roll_index, int roll_index_size,
+                       const int *name_order, const int *roll_order,
+                       const int *phone_order, int sorted_count,
+                       const int *trigram_lengths, const int *trigram_slots,
+                       const int *sound_lengths, const int *sound_slots) {
+    clearAddressBook(book);
+    if (strings_size == 0 || strings[0] != '\0') {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!recordFitsStrings(&contacts[i], strings, strings_size)) {
+            return 0;
+        }
+    }
+    if (!storedIndexesValid(contacts, count, roll_index, roll_index_size,
+                            name_order, roll_order, phone_order, sorted_count)) {
+        return 0;
+    }
+    if (!reserveContacts(book, count) || !reserveArena(&book->strings, strings_size)) {
+        return 0;
+    }
+    memcpy(book->contacts, contacts, count * sizeof(ContactRecord));
+    memcpy(book->strings.data, strings, strings_size);
+    book->strings.used = strings_size;
+    book->count = count;
+    if (!rebuildColumns(book) || !indexDepartments(book) || !adoptStrings(book)) {
+        return 0;
+    }
+
+    // Stored name index lists are adopted (rebuilding them was the slowest
+    // part of a start); an index that was not stored is built from the names
+    int trigrams_stored = trigram_lengths != NULL && trigram_slots != NULL;
+    int sounds_stored = sound_lengths != NULL && sound_slots != NULL;
+    if ((trigrams_stored &&
+         !loadPostingTable(&book->name_trigrams, trigram_lengths, trigram_slots, count)) ||
+        (sounds_stored && !loadPostingTable(&book->name_sounds, sound_lengths, sound_slots, count)) ||
+        !buildNameIndexes(book, !trigrams_stored, !sounds_stored)) {
+        return 0;
+    }
+
+    // Adopt the stored hash table only if it has the shape this build expects
+    if (roll_index != NULL && roll_index_size >= ROLL_INDEX_INITIAL_SIZE &&
+        (roll_index_size & (roll_index_size - 1)) == 0 && count * 2 <= roll_index_size) {
+        RollIndexEntry *table = malloc(roll_index_size * sizeof(RollIndexEntry));
+        if (table == NULL) {
+            printf("Memory allocation failed!\n");
+            return 0;
+        }
+        memcpy(table, roll_index, roll_index_size * sizeof(RollIndexEntry));
+        free(book->roll_index);
+        book->roll_index = table;
+        book->roll_index_size = roll_index_size;
+    } else if (!rebuildRollIndex(book)) {
+        return 0;
+    }
+
+    if (name_order != NULL && roll_order != NULL && phone_order != NULL &&
+        sorted_count > 0 && sorted_count <= count) {
+        if (!reserveSortedIndexes(book, count)) {
+            return 0;
+        }
+        memcpy(book->name_order, name_order, sorted_count * sizeof(int));
+        memcpy(book->roll_order, roll_order, sorted_count * sizeof(int));
+        memcpy(book->phone_order, phone_order, sorted_count * sizeof(int));
+        book->sorted_count = sorted_count;
+        book->order_count = sorted_count;
+        loadRollFences(book);
+    }
+    return refreshSortedIndexes(book);
+}
+
+// Validate name input
+int validateName(const char *name) {
+    if (strlen(name) == 0 || strlen(name) >= MAX_NAME_LEN) {
+        return 0;
+    }
+    // Check if name contains only letters and spaces
+    for (int i = 0; name[i]; i++) {
+        if (!isalpha(name[i]) && name[i] != ' ') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Validate phone number
+int validatePhone(const char *phone) {
+    if (strlen(phone) < 10 || strlen(phone) >= MAX_PHONE_LEN) {
+        return 0;
+    }
+    // Check if phone contains only digits, +, -, (, ), and spaces
+    for (int i = 0; phone[i]; i++) {
+        if (!isdigit(phone[i]) && phone[i] != '+' && phone[i] != '-' && 
+            phone[i] != '(' && phone[i] != ')' && phone[i] != ' ') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Validate email
+int validateEmail(const char *email) {
+    if (strlen(email) == 0 || strlen(email) >= MAX_EMAIL_LEN) {
+        return 0;
+    }
+    // Simple email validation - must contain @ and .
+    char *at_pos = strchr(email, '@');
+    char *dot_pos = strrchr(email, '.');
+    if (at_pos == NULL || dot_pos == NULL || at_pos > dot_pos) {
+        return 0;
+    }
+    return 1;
+}
+
+// Validate roll number (must be unique)
+int validateRollNo(int roll_no, const AddressBook *book, int exclude_index) {
+    if (roll_no <= 0) {
+        return 0;
+    }
+    int existing = rollIndexFind(book, roll_no);
+    if (existing != -1 && existing != exclude_index) {
+        return 0; // Roll number already exists
+    }
+    return 1;
+}
+
+// Strip a phone number down to its digits; returns the number of digits.
+// digits must hold MAX_PHONE_LEN bytes.
+int normalizePhone(const char *phone, char *digits) {
+    int len = 0;
+    for (int i = 0; phone[i] && len < MAX_PHONE_LEN - 1; i++) {
+        if (isdigit((unsigned char)phone[i])) {
+            digits[len++] = phone[i];
+        }
+    }
+    digits[len] = '\0';
+    return len;
+}
+
+// Check the phone is not already in use (only enforced with reject_duplicate_phones)
+int validatePhoneUnique(const char *phone, const AddressBook *book, int exclude_index) {
+    if (!book->reject_duplicate_phones) {
+        return 1;
+    }
+    char digits[MAX_PHONE_LEN];
+    normalizePhone(phone, digits);
+    return findPhoneMatch(book, digits, 1, exclude_index) == -1;
+}
+
+// Add a new contact
+int addContact(AddressBook *book) {
+    if (!resizeAddressBook(book)) {
+        return 0;
+    }
+
+    Contact new_contact;
+    char buffer[256];
+    
+    printf("\n=== Add New Contact ===\n");
+    
+    // Get name
+    do {
+        printf("Enter name: ");
+        fgets(buffer, sizeof(buffer), stdin);
+        buffer[strcspn(buffer, "\n")] = 0; // Remove newline
+        if (!validateName(buffer)) {
+            printf("Invalid name! Name should contain only letters and spaces (1-49 characters).\n");
+        }
+    } while (!validateName(buffer));
+    strcpy(new_contact.name, buffer);
+    
+    // Get phone
+    do {
+        printf("Enter phone number: ");
+        fgets(buffer, sizeof(buffer), stdin);
+        buffer[strcspn(buffer, "\n")] = 0;
+        if (!validatePhone(buffer)) {
+            printf("Invalid phone number! Must be 10-14 characters with digits and optional +, -, (), spaces.\n");
+        } else if (!validatePhoneUnique(buffer, book, -1)) {
+            printf("Phone number is already registered to another contact!\n");
+        }
+    } while (!validatePhone(buffer) || !validatePhoneUnique(buffer, book, -1));
+    strcpy(new_contact.phone, buffer);
+    
+    // Get email
+    do {
+        printf("Enter email: ");
+        fgets(buffer, sizeof(buffer), stdin);
+        buffer[strcspn(buffer, "\n")] = 0;
+        if (!validateEmail(buffer)) {
+            printf("Invalid email! Must contain @ and . in correct positions.\n");
+        }
+    } while (!validateEmail(buffer));
+    strcpy(new_contact.email, buffer);
+    
+    // Get roll number
+    do {
+        printf("Enter roll number: ");
+        scanf("%d", &new_contact.roll_no);
+        getchar(); // Consume newline
+        if (!validateRollNo(new_contact.roll_no, book, -1)) {
+            printf("Invalid roll number! Must be positive and unique.\n");
+        }
+    } while (!validateRollNo(new_contact.roll_no, book, -1));
+    
+    // Get department
+    do {
+        printf("Enter department: ");
+        fgets(buffer, sizeof(buffer), stdin);
+        buffer[strcspn(buffer, "\n")] = 0;
+        if (strlen(buffer) == 0 || strlen(buffer) >= MAX_DEPT_LEN) {
+            printf("Invalid department! Must be 1-49 characters.\n");
+        }
+    } while (strlen(buffer) == 0 || strlen(buffer) >= MAX_DEPT_LEN);
+    strcpy(new_contact.department, buffer);
+    
+    // Add contact to address book
+    if (!appendContact(book, &new_contact) || !refreshSortedIndexes(book)) {
+        return 0;
+    }
+    
+    printf("Contact added successfully!\n");
+    return 1;
+}
+
+// Number the live contact in slot is listed under: its position among the
+// live contacts, from 1, so deleted slots leave no gap in the list
+static int contactNumber(const AddressBook *book, int slot) {
+    int number = slot + 1;
+    for (int i = 0; i < book->free_count; i++) {
+        number -= book->free_slots[i] < slot;
+    }
+    return number;
+}
+
+// Deleted slots in ascending order, for numbering many rows at once
+typedef struct {
+    int *deleted;               // NULL when there are none (or memory ran out)
+    int count;
+} ContactNumbering;
+
+// Ascending order of ints, for qsort
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Take a sorted copy of the free list (nothing to copy in a book without deletions)
+static void startNumbering(ContactNumbering *numbering, const AddressBook *book) {
+    numbering->deleted = NULL;
+    numbering->count = 0;
+    if (book->free_count == 0) {
+        return;
+    }
+    numbering->deleted = malloc(book->free_count * sizeof(int));
+    if (numbering->deleted == NULL) {
+        return; // Rows are numbered from the free list directly instead
+    }
+    memcpy(numbering->deleted, book->free_slots, book->free_count * sizeof(int));
+    numbering->count = book->free_count;
+    qsort(numbering->deleted, numbering->count, sizeof(int), compareInts);
+}
+
+// Release a numbering's copy of the free list
+static void freeNumbering(ContactNumbering *numbering) {
+    free(numbering->deleted);
+    numbering->deleted = NULL;
+    numbering->count = 0;
+}
+
+// List number of the live contact in slot (see contactNumber), in O(log d)
+static int numberOf(const ContactNumbering *numbering, const AddressBook *book, int slot) {
+    if (numbering->deleted == NULL) {
+        return contactNumber(book, slot);
+    }
+    int left = 0, right = numbering->count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (numbering->deleted[mid] < slot) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return slot + 1 - left;
+}
+
+// Slot of the contact listed under number, or -1 if there is none
+static int slotOfNumber(const AddressBook *book, int number) {
+    if (number < 1 || number > countContacts(book)) {
+        return -1;
+    }
+    ContactNumbering numbering;
+    startNumbering(&numbering, book);
+    int slot = number - 1;
+    if (numbering.deleted != NULL) {
+        // Every deleted slot at or below the candidate pushes it one further
+        for (int i = 0; i < numbering.count && numbering.deleted[i] <= slot; i++) {
+            slot++;
+        }
+    } else if (book->free_count > 0) {
+        for (slot = 0; slot < book->count; slot++) {
+            if (isLiveSlot(book, slot) && --number == 0) {
+                break;
+            }
+        }
+    }
+    freeNumbering(&numbering);
+    return slot;
+}
+
+// Print one table row for the contact in slot, listed under number
+static void printContactRow(const AddressBook *book, int slot, int number) {
+    printf("%-4d %-20s %-15s %-30s %-8d %-15s\n", 
+           number, contactName(book, slot), contactPhone(book, slot), 
+           contactEmail(book, slot), book->contacts[slot].roll_no, contactDepartment(book, slot));
+}
+
+// Display the contact in slot
+void displayContact(const AddressBook *book, int slot) {
+    printContactRow(book, slot, contactNumber(book, slot));
+}
+
+// Append the contact in slot as one table row, laid out like displayContact
+static void renderContact(Renderer *renderer, const AddressBook *book, int slot, int number) {
+    renderNumber(renderer, number, 4);
+    renderChar(renderer, ' ');
+    renderPadded(renderer, contactName(book, slot), 20);
+    renderChar(renderer, ' ');
+    renderPadded(renderer, contactPhone(book, slot), 15);
+    renderChar(renderer, ' ');
+    renderPadded(renderer, contactEmail(book, slot), 30);
+    renderChar(renderer, ' ');
+    renderNumber(renderer, book->contacts[slot].roll_no, 8);
+    renderChar(renderer, ' ');
+    renderPadded(renderer, contactDepartment(book, slot), 15);
+    renderChar(renderer, '\n');
+}
+
+// Print the live contacts among slots[first..last) as table rows, written
+// in large blocks
+static void renderContacts(const AddressBook *book, const int *slots, int first, int last) {
+    Renderer renderer;
+    int buffered = initializeRenderer(&renderer, stdout);
+    ContactNumbering numbering;
+    startNumbering(&numbering, book);
+    for (int i = first; i < last; i++) {
+        int slot = slots[i];
+        if (!isLiveSlot(book, slot)) {
+            continue;
+        }
+        if (buffered) {
+            renderContact(&renderer, book, slot, numberOf(&numbering, book, slot));
+        } else {
+            printContactRow(book, slot, numberOf(&numbering, book, slot));
+        }
+    }
+    freeNumbering(&numbering);
+    if (buffered) {
+        freeRenderer(&renderer);
+    }
+}
+
+// Print the live contacts in slots first..last-1 as table rows numbered
+// from number, skipping deleted slots
+static void renderSlotRange(const AddressBook *book, int first, int last, int number) {
+    Renderer renderer;
+    int buffered = initializeRenderer(&renderer, stdout);
+    for (int slot = first; slot < last; slot++) {
+        if (!isLiveSlot(book, slot)) {
+            continue;
+        }
+        if (buffered) {
+            renderContact(&renderer, book, slot, number);
+        } else {
+            printContactRow(book, slot, number);
+        }
+        number++;
+    }
+    if (buffered) {
+        freeRenderer(&renderer);
+    }
+}
+
+// List all contacts
+void listContacts(const AddressBook *book) {
+    if (countContacts(book) == 0) {
+        printf("\nNo contacts found in Find My Student.\n");
+        return;
+    }
+    
+    printf("\n=== Find My Student Contacts ===\n");
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    
+    renderSlotRange(book, 0, book->count, 1);
+    printf("\nTotal contacts: %d\n", countContacts(book));
+}
+
+// List one page: numbers first + 1 to first + page_size. Only the page's
+// slots (and the deleted ones between them) are read, so paging a large
+// book costs the same as a small one.
+void listContactsPage(const AddressBook *book, int first, int page_size) {
+    int total = countContacts(book);
+    if (total == 0) {
+        printf("\nNo contacts found in Find My Student.\n");
+        return;
+    }
+    if (first < 0 || first >= total) {
+        first = 0;
+    }
+    int last = page_size < total - first ? first + page_size : total;
+    int first_slot = slotOfNumber(book, first + 1);
+    int last_slot = first_slot;
+    for (int rows = 0; rows < last - first; last_slot++) {
+        rows += isLiveSlot(book, last_slot);
+    }
+    
+    printf("\n=== Find My Student Contacts (No. %d-%d of %d) ===\n", first + 1, last, total);
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    
+    renderSlotRange(book, first_slot, last_slot, first + 1);
+    printf("\nTotal contacts: %d\n", total);
+}
+
+// Page through the list page_size contacts at a time; lists everything at
+// once when the book fits on one page or page_size is 0
+void browseContacts(const AddressBook *book, int page_size) {
+    int total = countContacts(book);
+    if (page_size <= 0 || total <= page_size) {
+        listContacts(book);
+        return;
+    }
+    
+    int first = 0;
+    char line[32];
+    while (1) {
+        listContactsPage(book, first, page_size);
+        printf("[Enter] next page, p previous, g <No.> go to, q quit: ");
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            return;
+        }
+        if (strchr(line, '\n') == NULL) {
+            int c;
+            while ((c = getchar()) != '\n' && c != EOF) {
+                // Discard the rest of an overlong line
+            }
+        }
+        
+        if (line[0] == 'q' || line[0] == 'Q') {
+            return;
+        } else if (line[0] == 'p' || line[0] == 'P') {
+            first = first >= page_size ? first - page_size : 0;
+        } else if (line[0] == 'g' || line[0] == 'G') {
+            long number = strtol(line + 1, NULL, 10);
+            if (number >= 1 && number <= total) {
+                first = (int)number - 1;
+            } else {
+                printf("Invalid number! Enter 1-%d.\n", total);
+            }
+        } else if (first + page_size < total) {
+            first += page_size;
+        } else {
+            return; // Past the last page
+        }
+    }
+}
+
+// Linear search by name
+int linearSearchByName(const AddressBook *book, const char *name) {
+    STATS_START(start);
+    int found = -1;
+    if (book->layout == STORAGE_SCAN_CACHE) {
+        for (int i = 0; i < book->count && found == -1; i++) {
+            if (isLiveSlot(book, i) && strcasecmp(book->columns.name[i], name) == 0) {
+                found = i;
+            }
+        }
+    } else {
+        for (int i = 0; i < book->count && found == -1; i++) {
+            if (isLiveSlot(book, i) && strcasecmp(contactName(book, i), name) == 0) {
+                found = i;
+            }
+        }
+    }
+    STATS_STOP(STAT_LINEAR_NAME, start);
+    return found;
+}
+
+// Linear search by phone
+int linearSearchByPhone(const AddressBook *book, const char *phone) {
+    STATS_START(start);
+    int found = -1;
+    if (book->layout == STORAGE_SCAN_CACHE) {
+        for (int i = 0; i < book->count && found == -1; i++) {
+            if (isLiveSlot(book, i) && strcmp(book->columns.phone[i], phone) == 0) {
+                found = i;
+            }
+        }
+    } else {
+        for (int i = 0; i < book->count && found == -1; i++) {
+            if (isLiveSlot(book, i) && strcmp(contactPhone(book, i), phone) == 0) {
+                found = i;
+            }
+        }
+    }
+    STATS_STOP(STAT_LINEAR_PHONE, start);
+    return found;
+}
+
+// Search by roll number (answered from the hash index)
+int linearSearchByRoll(const AddressBook *book, int roll_no) {
+    STATS_START(start);
+    int slot = rollIndexFind(book, roll_no);
+    STATS_STOP(STAT_LINEAR_ROLL, start);
+    return slot;
+}
+
+// Search by department (answered from the department posting lists)
+int linearSearchByDepartment(const AddressBook *book, const char *department) {
+    STATS_START(start);
+    printf("\n=== Contacts in %s Department ===\n", department);
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    
+    const int *slots;
+    int found = findContactsByDepartment(book, department, &slots);
+    renderContacts(book, slots, 0, found);
+    STATS_STOP(STAT_LINEAR_DEPARTMENT, start);
+    
+    if (found == 0) {
+        printf("No contacts found in %s department.\n", department);
+        return -1;
+    }
+    printf("\nFound %d contact(s) in %s department.\n", found, department);
+    return found;
+}
+
+// Precomputed sort key: the key orders most pairs without touching the contact
+typedef struct {
+    unsigned long long key;
+    int slot;
+} SortEntry;
+
+// Pack the first 8 case-folded characters of a name into a comparable integer
+static unsigned long long nameSortKey(const char *name) {
+    unsigned long long key = 0;
+    int i = 0;
+    for (; i < 8 && name[i]; i++) {
+        key = (key << 8) | (unsigned char)tolower((unsigned char)name[i]);
+    }
+    for (; i < 8; i++) {
+        key <<= 8;
+    }
+    return key;
+}
+
+// Compare two sort entries, falling back to the full name only on a key tie
+static int compareSortEntries(const AddressBook *book, SortField field,
+                              const SortEntry *a, const SortEntry *b) {
+    if (a->key != b->key) {
+        return a->key < b->key ? -1 : 1;
+    }
+    if (field == SORT_BY_NAME) {
+        return strcasecmp(slotName(book, a->slot), slotName(book, b->slot));
+    }
+    if (field == SORT_BY_PHONE) {
+        char digits_a[MAX_PHONE_LEN], digits_b[MAX_PHONE_LEN];
+        normalizePhone(slotPhone(book, a->slot), digits_a);
+        normalizePhone(slotPhone(book, b->slot), digits_b);
+        return strcmp(digits_a, digits_b);
+    }
+    return 0;
+}
+
+// Fill order[0..n-1] with slots first..first+n-1 in sorted order (stable merge sort)
+static int sortSlotRange(const AddressBook *book, SortField field, int first, int n, int *order) {
+    if (n == 0) {
+        return 1;
+    }
+
+    SortEntry *entries = malloc(n * sizeof(SortEntry));
+    SortEntry *scratch = malloc(n * sizeof(SortEntry));
+    if (entries == NULL || scratch == NULL) {
+        printf("Memory allocation failed!\n");
+        free(entries);
+        free(scratch);
+        return 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int slot = first + i;
+        entries[i].slot = slot;
+        if (field == SORT_BY_NAME) {
+            entries[i].key = nameSortKey(slotName(book, slot));
+        } else if (field == SORT_BY_PHONE) {
+            char digits[MAX_PHONE_LEN];
+            normalizePhone(slotPhone(book, slot), digits);
+            entries[i].key = nameSortKey(digits);
+        } else {
+            // Flip the sign bit so negative numbers order before positive ones
+            entries[i].key = (unsigned int)slotRollNo(book, slot) ^ 0x80000000u;
+        }
+    }
+
+    // Bottom-up merge sort moves 16-byte entries instead of whole contacts
+    SortEntry *src = entries, *dst = scratch;
+    for (int width = 1; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (compareSortEntries(book, field, &src[j], &src[i]) < 0) {
+                    dst[k++] = src[j++];
+                } else {
+                    dst[k++] = src[i++];
+                }
+            }
+            while (i < mid) {
+                dst[k++] = src[i++];
+            }
+            while (j < hi) {
+                dst[k++] = src[j++];
+            }
+        }
+        SortEntry *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    for (int i = 0; i < n; i++) {
+        order[i] = src[i].slot;
+    }
+    free(entries);
+    free(scratch);
+    return 1;
+}
+
+// Fill order with the live contact slots in sorted order (order must hold
+// count entries); returns how many were written, or -1 if memory ran out
+int sortContactOrder(const AddressBook *book, SortField field, int *order) {
+    if (!sortSlotRange(book, field, 0, book->count, order)) {
+        return -1;
+    }
+    int live = 0;
+    for (int i = 0; i < book->count; i++) {
+        if (isLiveSlot(book, order[i])) {
+            order[live++] = order[i]; // Deleted slots sort as empty contacts
+        }
+    }
+    return live;
+}
+
+// Total order used by the sorted indexes: field value, then slot
+static int compareSlots(const AddressBook *book, SortField field, int a, int b) {
+    if (field == SORT_BY_NAME) {
+        int cmp = strcasecmp(slotName(book, a), slotName(book, b));
+        if (cmp != 0) {
+            return cmp;
+        }
+    } else if (field == SORT_BY_PHONE) {
+        char digits_a[MAX_PHONE_LEN], digits_b[MAX_PHONE_LEN];
+        normalizePhone(slotPhone(book, a), digits_a);
+        normalizePhone(slotPhone(book, b), digits_b);
+        int cmp = strcmp(digits_a, digits_b);
+        if (cmp != 0) {
+            return cmp;
+        }
+    } else if (slotRollNo(book, a) != slotRollNo(book, b)) {
+        return slotRollNo(book, a) < slotRollNo(book, b) ? -1 : 1;
+    }
+    return (a > b) - (a < b);
+}
+
+// Position of the first entry in order[0..n-1] that is not less than slot
+static int orderLowerBound(const AddressBook *book, SortField field,
+                           const int *order, int n, int slot) {
+    int left = 0, right = n;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (compareSlots(book, field, order[mid], slot) < 0) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Remove a covered slot from one order (must be called before its key changes)
+static void orderRemove(AddressBook *book, SortField field, int *order, int slot) {
+    int n = book->order_count;
+    int pos = orderLowerBound(book, field, order, n, slot);
+    if (pos < n && order[pos] == slot) {
+        memmove(&order[pos], &order[pos + 1], (n - pos - 1) * sizeof(int));
+        if (field == SORT_BY_ROLL) {
+            fenceRemove(&book->roll_fences, pos);
+        }
+    }
+}
+
+// Insert a slot into one order holding n entries (binary insertion)
+static void orderInsert(AddressBook *book, SortField field, int *order, int n, int slot) {
+    int pos = orderLowerBound(book, field, order, n, slot);
+    memmove(&order[pos + 1], &order[pos], (n - pos) * sizeof(int));
+    order[pos] = slot;
+    if (field == SORT_BY_ROLL) {
+        fenceInsert(&book->roll_fences, pos, slotRollNo(book, slot));
+    }
+}
+
+// Copy the roll number of every position of roll_order into the fence index
+static void loadRollFences(AddressBook *book) {
+    for (int i = 0; i < book->order_count; i++) {
+        book->roll_fences.keys[i] = slotRollNo(book, book->roll_order[i]);
+    }
+    rebuildFences(&book->roll_fences, book->order_count);
+}
+
+// Merge the sorted pending slots into one order in a single pass
+static void orderMerge(const AddressBook *book, SortField field, int *order, int n,
+                       const int *pending, int k, int *out) {
+    int i = 0, j = 0, o = 0;
+    while (i < n && j < k) {
+        if (compareSlots(book, field, pending[j], order[i]) < 0) {
+            out[o++] = pending[j++];
+        } else {
+            out[o++] = order[i++];
+        }
+    }
+    while (i < n) {
+        out[o++] = order[i++];
+    }
+    while (j < k) {
+        out[o++] = pending[j++];
+    }
+}
+
+// Make room for at least entries slots in both sorted indexes
+static int reserveSortedIndexes(AddressBook *book, int entries) {
+    if (book->order_capacity >= entries) {
+        return 1;
+    }
+    int new_capacity = book->capacity > entries ? book->capacity : entries;
+    int *name_order = realloc(book->name_order, new_capacity * sizeof(int));
+    if (name_order == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    book->name_order = name_order;
+    int *roll_order = realloc(book->roll_order, new_capacity * sizeof(int));
+    if (roll_order == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    book->roll_order = roll_order;
+    int *phone_order = realloc(book->phone_order, new_capacity * sizeof(int));
+    if (phone_order == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    book->phone_order = phone_order;
+    if (!reserveFenceIndex(&book->roll_fences, new_capacity)) {
+        return 0;
+    }
+    book->order_capacity = new_capacity;
+    STATS_REALLOC(3 * new_capacity * sizeof(int));
+    return 1;
+}
+
+// Fold contacts appended since the last refresh into the sorted indexes
+int refreshSortedIndexes(AddressBook *book) {
+    int n = book->order_count;
+    int first = book->sorted_count;
+    int k = book->count - first;
+    if (k <= 0) {
+        return 1;
+    }
+
+    if (!reserveSortedIndexes(book, book->count)) {
+        return 0;
+    }
+
+    // A handful of new contacts are cheapest to place by binary insertion
+    if (k <= SORTED_INSERT_THRESHOLD) {
+        for (int slot = first; slot < book->count; slot++) {
+            if (!isLiveSlot(book, slot)) {
+                continue;
+            }
+            orderInsert(book, SORT_BY_NAME, book->name_order, n, slot);
+            orderInsert(book, SORT_BY_ROLL, book->roll_order, n, slot);
+            orderInsert(book, SORT_BY_PHONE, book->phone_order, n, slot);
+            n++;
+        }
+        book->sorted_count = book->count;
+        book->order_count = n;
+        return 1;
+    }
+
+    // Larger batches are sorted on their own and merged in O(n + k log k)
+    int *pending = malloc(k * sizeof(int));
+    int *merged = malloc(book->count * sizeof(int));
+    if (pending == NULL || merged == NULL) {
+        printf("Memory allocation failed!\n");
+        free(pending);
+        free(merged);
+        return 0;
+    }
+    SortField fields[3] = {SORT_BY_NAME, SORT_BY_ROLL, SORT_BY_PHONE};
+    int *orders[3] = {book->name_order, book->roll_order, book->phone_order};
+    int live = 0;
+    for (int f = 0; f < 3; f++) {
+        if (!sortSlotRange(book, fields[f], first, k, pending)) {
+            free(pending);
+            free(merged);
+            return 0;
+        }
+        live = 0;
+        for (int i = 0; i < k; i++) {
+            if (isLiveSlot(book, pending[i])) {
+                pending[live++] = pending[i]; // Deleted pending slots stay out
+            }
+        }
+        orderMerge(book, fields[f], orders[f], n, pending, live, merged);
+        memcpy(orders[f], merged, (n + live) * sizeof(int));
+    }
+    free(pending);
+    free(merged);
+    book->sorted_count = book->count;
+    book->order_count = n + live;
+    loadRollFences(book);
+    return 1;
+}
+
+// Reorder the contacts array in one pass so that it holds the live slots
+// order[0..live-1]; deleted slots are dropped on the way
+static int applyContactOrder(AddressBook *book, const int *order, int live) {
+    ContactRecord *sorted = malloc(book->capacity * sizeof(ContactRecord));
+    if (sorted == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    for (int i = 0; i < live; i++) {
+        sorted[i] = book->contacts[order[i]];
+    }
+    free(book->contacts);
+    book->contacts = sorted;
+    book->count = live;
+    book->free_count = 0;
+    book->sorted_count = 0;
+    book->order_count = 0;
+    book->roll_fences.count = 0;
+    return rebuildColumns(book) && rebuildDepartmentIndex(book) && rebuildNameIndexes(book) &&
+           rebuildRollIndex(book) && refreshSortedIndexes(book);
+}
+
+// Sort the contacts array by the given field
+static void sortContactsBy(AddressBook *book, SortField field) {
+    if (countContacts(book) < 2) {
+        return;
+    }
+    STATS_START(start);
+    int *order = malloc(book->count * sizeof(int));
+    if (order == NULL) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    int live = sortContactOrder(book, field, order);
+    if (live >= 0) {
+        applyContactOrder(book, order, live);
+    }
+    free(order);
+    STATS_STOP(STAT_SORT, start);
+}
+
+// Sort contacts by name for binary search
+void sortContactsByName(AddressBook *book) {
+    sortContactsBy(book, SORT_BY_NAME);
+}
+
+// Sort contacts by roll number for binary search
+void sortContactsByRoll(AddressBook *book) {
+    sortContactsBy(book, SORT_BY_ROLL);
+}
+
+// Binary search by name over the persistent name index
+int binarySearchByName(const AddressBook *book, const char *name) {
+    STATS_START(start);
+    int left = 0, right = book->order_count - 1;
+    int found = -1;
+    
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        int cmp = strcasecmp(slotName(book, book->name_order[mid]), name);
+        
+        if (cmp < 0) {
+            left = mid + 1;
+        } else {
+            if (cmp == 0) {
+                found = book->name_order[mid]; // Keep going left for the first match
+            }
+            right = mid - 1;
+        }
+    }
+    
+    // Contacts appended since the last refresh are not indexed yet
+    for (int i = book->sorted_count; i < book->count && found == -1; i++) {
+        if (isLiveSlot(book, i) && strcasecmp(slotName(book, i), name) == 0) {
+            found = i;
+        }
+    }
+    STATS_STOP(STAT_BINARY_NAME, start);
+    return found;
+}
+
+// Binary search by roll number over the persistent roll index (through its
+// fence pointers, so no contact is read until the match is found)
+int binarySearchByRoll(const AddressBook *book, int roll_no) {
+    STATS_START(start);
+    const FenceIndex *fences = &book->roll_fences;
+    int pos = fenceLowerBound(fences, roll_no);
+    int found = pos < fences->count && fences->keys[pos] == roll_no ? book->roll_order[pos] : -1;
+    
+    // Contacts appended since the last refresh are not indexed yet
+    for (int i = book->sorted_count; i < book->count && found == -1; i++) {
+        if (isLiveSlot(book, i) && slotRollNo(book, i) == roll_no) {
+            found = i;
+        }
+    }
+    STATS_STOP(STAT_BINARY_ROLL, start);
+    return found;
+}
+
+// Collect up to max_slots contacts whose roll number lies in [low, high], in
+// roll order, then any not indexed yet. Returns the total number of matches,
+// so max_slots 0 just counts them: O(log n) plus the matches copied.
+int findContactsByRollRange(const AddressBook *book, int low, int high, int *slots, int max_slots) {
+    STATS_START(start);
+    int found = 0;
+    if (low <= high) {
+        int first = fenceLowerBound(&book->roll_fences, low);
+        int last = fenceUpperBound(&book->roll_fences, high);
+        for (int i = first; i < last && found < max_slots; i++) {
+            slots[found++] = book->roll_order[i];
+        }
+        found = last - first;
+        
+        // Contacts appended since the last refresh are not indexed yet
+        for (int i = book->sorted_count; i < book->count; i++) {
+            int roll_no = slotRollNo(book, i);
+            if (isLiveSlot(book, i) && roll_no >= low && roll_no <= high) {
+                if (found < max_slots) {
+                    slots[found] = i;
+                }
+                found++;
+            }
+        }
+    }
+    STATS_STOP(STAT_ROLL_RANGE, start);
+    return found;
+}
+
+// Contact with the lowest roll number (highest when last is set), or -1
+static int rollExtreme(const AddressBook *book, int last) {
+    const FenceIndex *fences = &book->roll_fences;
+    int found = -1;
+    if (fences->count > 0) {
+        found = book->roll_order[last ? fences->count - 1 : 0];
+    }
+    for (int i = book->sorted_count; i < book->count; i++) {
+        if (isLiveSlot(book, i) &&
+            (found == -1 || (slotRollNo(book, i) > slotRollNo(book, found)) == last)) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+// Contact with the lowest roll number, or -1 if the book is empty
+int firstContactByRoll(const AddressBook *book) {
+    return rollExtreme(book, 0);
+}
+
+// Contact with the highest roll number, or -1 if the book is empty
+int lastContactByRoll(const AddressBook *book) {
+    return rollExtreme(book, 1);
+}
+
+// First position in name_order whose name compares >= prefix over its first
+// len characters (upper == 0), or > prefix (upper == 1), ignoring case
+static int namePrefixBound(const AddressBook *book, const char *prefix, size_t len, int upper) {
+    int left = 0, right = book->order_count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        int cmp = strncasecmp(slotName(book, book->name_order[mid]), prefix, len);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Autocomplete: the first max_slots contacts (in name order) whose name starts
+// with prefix, ignoring case. Returns the total number of matches.
+int findContactsByNamePrefix(const AddressBook *book, const char *prefix, int *slots, int max_slots) {
+    STATS_START(start);
+    size_t len = strlen(prefix);
+    int first = namePrefixBound(book, prefix, len, 0);
+    int last = namePrefixBound(book, prefix, len, 1);
+    int found = 0;
+    for (int i = first; i < last && found < max_slots; i++) {
+        slots[found++] = book->name_order[i];
+    }
+    int total = last - first;
+    
+    // Contacts appended since the last refresh are not indexed yet: slot each
+    // match into the sorted result if it ranks among the first max_slots
+    for (int slot = book->sorted_count; slot < book->count; slot++) {
+        if (!isLiveSlot(book, slot) || strncasecmp(slotName(book, slot), prefix, len) != 0) {
+            continue;
+        }
+        total++;
+        int pos = found;
+        while (pos > 0 && compareSlots(book, SORT_BY_NAME, slot, slots[pos - 1]) < 0) {
+            pos--;
+        }
+        if (pos >= max_slots) {
+            continue;
+        }
+        int keep = found < max_slots ? found : max_slots - 1;
+        memmove(&slots[pos + 1], &slots[pos], (keep - pos) * sizeof(int));
+        slots[pos] = slot;
+        if (found < max_slots) {
+            found++;
+        }
+    }
+    STATS_STOP(STAT_NAME_PREFIX, start);
+    return total;
+}
+
+// Default typo allowance for a fuzzy query: longer names tolerate more edits
+int fuzzyDistanceBound(const char *query) {
+    size_t len = strlen(query);
+    if (len <= 4) {
+        return 1;
+    }
+    return len <= 10 ? 2 : 3;
 }
 
-// List all contacts
-void listContacts(const AddressBook *book) {
-    if (book->count == 0) {
-        printf("\nNo contacts found in Find My Student.\n");
-        return;
+// Typo-tolerant name search. Candidates are the names sharing enough trigrams
+// with the query (k edits can destroy at most 3k of them); each is then
+// checked with an edit distance that stops once it exceeds max_distance.
+// Fills up to max_results slots ordered by distance, then name, and returns
+// how many were found.
+int fuzzySearchByName(const AddressBook *book, const char *query, int max_distance,
+                      int *slots, int *distances, int max_results) {
+    STATS_START(start);
+    if (book->name_trigrams.lists == NULL || book->count == 0 || max_results <= 0) {
+        return 0;
+    }
+    int grams[MAX_NAME_TRIGRAMS];
+    int gram_count = nameTrigrams(query, grams);
+    int min_shared = gram_count - 3 * max_distance;
+    if (min_shared < 1) {
+        min_shared = 1;
     }
     
-    printf("\n=== Find My Student Contacts ===\n");
-    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
-           "No.", "Name", "Phone", "Email", "Roll No", "Department");
-    printf("================================================================================\n");
+    unsigned char *shared = calloc(book->count, 1);
+    int *candidates = malloc(book->count * sizeof(int));
+    if (shared == NULL || candidates == NULL) {
+        printf("Memory allocation failed!\n");
+        free(shared);
+        free(candidates);
+        return 0;
+    }
     
-    for (int i = 0; i < book->count; i++) {
-        displayContact(&book->contacts[i], i);
+    // Count shared trigrams per slot; a slot becomes a candidate when it
+    // reaches the threshold
+    int candidate_count = 0;
+    for (int g = 0; g < gram_count; g++) {
+        const PostingList *list = &book->name_trigrams.lists[grams[g]];
+        for (int i = 0; i < list->count; i++) {
+            int slot = list->slots[i];
+            if (++shared[slot] == min_shared) {
+                candidates[candidate_count++] = slot;
+            }
+        }
+    }
+    
+    // Verify candidates and keep the best max_results by (distance, name, slot)
+    int found = 0;
+    for (int c = 0; c < candidate_count; c++) {
+        int slot = candidates[c];
+        int distance = boundedEditDistance(slotName(book, slot), query, max_distance);
+        if (distance > max_distance) {
+            continue;
+        }
+        int pos = found;
+        while (pos > 0 && (distances[pos - 1] > distance ||
+                           (distances[pos - 1] == distance &&
+                            compareSlots(book, SORT_BY_NAME, slot, slots[pos - 1]) < 0))) {
+            pos--;
+        }
+        if (pos >= max_results) {
+            continue;
+        }
+        int keep = found < max_results ? found : max_results - 1;
+        memmove(&slots[pos + 1], &slots[pos], (keep - pos) * sizeof(int));
+        memmove(&distances[pos + 1], &distances[pos], (keep - pos) * sizeof(int));
+        slots[pos] = slot;
+        distances[pos] = distance;
+        if (found < max_results) {
+            found++;
+        }
     }
-    printf("\nTotal contacts: %d\n", book->count);
+    free(shared);
+    free(candidates);
+    STATS_STOP(STAT_FUZZY_NAME, start);
+    return found;
 }
 
-// Linear search by name
-int linearSearchByName(const AddressBook *book, const char *name) {
-    for (int i = 0; i < book->count; i++) {
-        if (strcasecmp(book->contacts[i].name, name) == 0) {
-            return i;
+// Is slot in the ascending posting list?
+static int postingContains(const PostingList *list, int slot) {
+    int left = 0, right = list->count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (list->slots[mid] < slot) {
+            left = mid + 1;
+        } else {
+            right = mid;
         }
     }
-    return -1;
+    return left < list->count && list->slots[left] == slot;
 }
 
-// Linear search by phone
-int linearSearchByPhone(const AddressBook *book, const char *phone) {
-    for (int i = 0; i < book->count; i++) {
-        if (strcmp(book->contacts[i].phone, phone) == 0) {
-            return i;
+// "Sounds like" name search: contacts whose name has a token sounding like
+// every token of the query (Soundex), e.g. "Jon Smyth" finds "John Smith".
+// Walks the smallest code bucket and probes the others, so only contacts
+// sharing a code are touched. Fills up to max_slots slots in slot order and
+// returns the total number of matches.
+int findContactsBySound(const AddressBook *book, const char *query, int *slots, int max_slots) {
+    STATS_START(start);
+    int codes[MAX_POSTING_KEYS];
+    int code_count = nameSoundexCodes(query, codes);
+    if (book->name_sounds.lists == NULL || code_count == 0) {
+        return 0;
+    }
+    const PostingList *smallest = &book->name_sounds.lists[codes[0]];
+    for (int c = 1; c < code_count; c++) {
+        if (book->name_sounds.lists[codes[c]].count < smallest->count) {
+            smallest = &book->name_sounds.lists[codes[c]];
         }
     }
-    return -1;
+    
+    int found = 0;
+    for (int i = 0; i < smallest->count; i++) {
+        int slot = smallest->slots[i];
+        int c = 0;
+        while (c < code_count && postingContains(&book->name_sounds.lists[codes[c]], slot)) {
+            c++;
+        }
+        if (c < code_count) {
+            continue;
+        }
+        if (found < max_slots) {
+            slots[found] = slot;
+        }
+        found++;
+    }
+    STATS_STOP(STAT_SOUNDS_LIKE, start);
+    return found;
 }
 
-// Linear search by roll number
-int linearSearchByRoll(const AddressBook *book, int roll_no) {
-    for (int i = 0; i < book->count; i++) {
-        if (book->contacts[i].roll_no == roll_no) {
-            return i;
+// First position in phone_order whose normalized phone is >= digits[0..len)
+static int phoneLowerBound(const AddressBook *book, const char *digits, int len) {
+    int left = 0, right = book->order_count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        char key[MAX_PHONE_LEN];
+        normalizePhone(slotPhone(book, book->phone_order[mid]), key);
+        if (strncmp(key, digits, len) < 0) {
+            left = mid + 1;
+        } else {
+            right = mid;
         }
     }
-    return -1;
+    return left;
 }
 
-// Linear search by department
-int linearSearchByDepartment(const AddressBook *book, const char *department) {
-    printf("\n=== Contacts in %s Department ===\n", department);
-    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
-           "No.", "Name", "Phone", "Email", "Roll No", "Department");
-    printf("================================================================================\n");
-    
-    int found = 0;
-    for (int i = 0; i < book->count; i++) {
-        if (strcasecmp(book->contacts[i].department, department) == 0) {
-            displayContact(&book->contacts[i], i);
-            found++;
+// Does the contact in slot match digits (as a prefix, or exactly)?
+static int phoneMatches(const AddressBook *book, int slot, const char *digits, int len, int exact) {
+    char key[MAX_PHONE_LEN];
+    int key_len = normalizePhone(slotPhone(book, slot), key);
+    return strncmp(key, digits, len) == 0 && (!exact || key_len == len);
+}
+
+// First slot (in phone order, then pending slots) whose phone matches digits,
+// skipping exclude_slot; -1 if none
+static int findPhoneMatch(const AddressBook *book, const char *digits, int exact, int exclude_slot) {
+    int len = (int)strlen(digits);
+    for (int i = phoneLowerBound(book, digits, len); i < book->order_count; i++) {
+        int slot = book->phone_order[i];
+        if (!phoneMatches(book, slot, digits, len, 0)) {
+            break;
+        }
+        if (slot != exclude_slot && phoneMatches(book, slot, digits, len, exact)) {
+            return slot;
         }
     }
     
-    if (found == 0) {
-        printf("No contacts found in %s department.\n", department);
-        return -1;
+    // Contacts appended since the last refresh are not indexed yet
+    for (int i = book->sorted_count; i < book->count; i++) {
+        if (i != exclude_slot && isLiveSlot(book, i) && phoneMatches(book, i, digits, len, exact)) {
+            return i;
+        }
     }
-    printf("\nFound %d contact(s) in %s department.\n", found, department);
-    return found;
+    return -1;
 }
 
-// Sort contacts by name for binary search
-void sortContactsByName(AddressBook *book) {
-    for (int i = 0; i < book->count - 1; i++) {
-        for (int j = 0; j < book->count - i - 1; j++) {
-            if (strcasecmp(book->contacts[j].name, book->contacts[j + 1].name) > 0) {
-                Contact temp = book->contacts[j];
-                book->contacts[j] = book->contacts[j + 1];
-                book->contacts[j + 1] = temp;
+// Find the contact whose phone has exactly these digits (punctuation ignored)
+int findContactByPhone(const AddressBook *book, const char *phone) {
+    STATS_START(start);
+    char digits[MAX_PHONE_LEN];
+    int slot = normalizePhone(phone, digits) == 0 ? -1 : findPhoneMatch(book, digits, 1, -1);
+    STATS_STOP(STAT_FIND_PHONE, start);
+    return slot;
+}
+
+// Collect up to max_slots contacts whose phone digits start with the digits of
+// prefix, in phone order. Returns the total number of matches.
+int findContactsByPhonePrefix(const AddressBook *book, const char *prefix, int *slots, int max_slots) {
+    STATS_START(start);
+    char digits[MAX_PHONE_LEN];
+    int len = normalizePhone(prefix, digits);
+    int found = 0;
+    if (len == 0) {
+        return 0;
+    }
+    
+    for (int i = phoneLowerBound(book, digits, len); i < book->order_count; i++) {
+        int slot = book->phone_order[i];
+        if (!phoneMatches(book, slot, digits, len, 0)) {
+            break;
+        }
+        if (found < max_slots) {
+            slots[found] = slot;
+        }
+        found++;
+    }
+    
+    // Contacts appended since the last refresh are not indexed yet
+    for (int i = book->sorted_count; i < book->count; i++) {
+        if (isLiveSlot(book, i) && phoneMatches(book, i, digits, len, 0)) {
+            if (found < max_slots) {
+                slots[found] = i;
             }
+            found++;
         }
     }
+    STATS_STOP(STAT_PHONE_PREFIX, start);
+    return found;
 }
 
-// Sort contacts by roll number for binary search
-void sortContactsByRoll(AddressBook *book) {
-    for (int i = 0; i < book->count - 1; i++) {
-        for (int j = 0; j < book->count - i - 1; j++) {
-            if (book->contacts[j].roll_no > book->contacts[j + 1].roll_no) {
-                Contact temp = book->contacts[j];
-                book->contacts[j] = book->contacts[j + 1];
-                book->contacts[j + 1] = temp;
-            }
+// Print a warning for every contact whose phone digits repeat an earlier
+// contact's; returns how many were found
+int reportDuplicatePhones(const AddressBook *book) {
+    int duplicates = 0;
+    for (int i = 1; i < book->order_count; i++) {
+        int first = book->phone_order[i - 1];
+        int slot = book->phone_order[i];
+        char digits[MAX_PHONE_LEN], previous[MAX_PHONE_LEN];
+        normalizePhone(slotPhone(book, slot), digits);
+        normalizePhone(slotPhone(book, first), previous);
+        if (digits[0] != '\0' && strcmp(digits, previous) == 0) {
+            printf("Warning: Roll number %d has the same phone number as roll number %d.\n",
+                   book->contacts[slot].roll_no, book->contacts[first].roll_no);
+            duplicates++;
         }
     }
+    return duplicates;
 }
 
-// Binary search by name
-int binarySearchByName(const AddressBook *book, const char *name) {
-    int left = 0, right = book->count - 1;
+// Show the top name matches for a prefix, letting the user keep typing to refine
+static void autocompleteByName(const AddressBook *book, char *prefix, size_t size) {
+    char more[256];
+    int slots[NAME_AUTOCOMPLETE_RESULTS];
     
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-        int cmp = strcasecmp(book->contacts[mid].name, name);
+    while (1) {
+        int total = findContactsByNamePrefix(book, prefix, slots, NAME_AUTOCOMPLETE_RESULTS);
+        if (total == 0) {
+            printf("No names start with '%s'.\n", prefix);
+            return;
+        }
+        printf("\n=== Names Starting With '%s' ===\n", prefix);
+        printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+               "No.", "Name", "Phone", "Email", "Roll No", "Department");
+        printf("================================================================================\n");
+        int shown = total < NAME_AUTOCOMPLETE_RESULTS ? total : NAME_AUTOCOMPLETE_RESULTS;
+        for (int i = 0; i < shown; i++) {
+            displayContact(book, slots[i]);
+        }
+        printf("\nShowing %d of %d match(es).\n", shown, total);
+        if (total == shown) {
+            return;
+        }
         
-        if (cmp == 0) {
-            return mid;
-        } else if (cmp < 0) {
-            left = mid + 1;
-        } else {
-            right = mid - 1;
+        printf("Type more letters to refine (Enter to finish): %s", prefix);
+        if (fgets(more, sizeof(more), stdin) == NULL) {
+            return;
         }
+        more[strcspn(more, "\n")] = 0;
+        if (more[0] == '\0' || strlen(prefix) + strlen(more) >= size) {
+            return;
+        }
+        strcat(prefix, more);
     }
-    return -1;
 }
 
-// Binary search by roll number
-int binarySearchByRoll(const AddressBook *book, int roll_no) {
-    int left = 0, right = book->count - 1;
+// Show the closest names to a possibly misspelled query
+static void fuzzySearchMenu(const AddressBook *book, const char *query) {
+    int slots[FUZZY_MAX_RESULTS], distances[FUZZY_MAX_RESULTS];
+    int bound = fuzzyDistanceBound(query);
+    int found = fuzzySearchByName(book, query, bound, slots, distances, FUZZY_MAX_RESULTS);
+    if (found == 0) {
+        printf("No names within %d edit(s) of '%s'.\n", bound, query);
+        return;
+    }
+    printf("\n=== Closest Matches for '%s' ===\n", query);
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s %s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department", "Edits");
+    printf("================================================================================\n");
+    for (int i = 0; i < found; i++) {
+        int slot = slots[i];
+        printf("%-4d %-20s %-15s %-30s %-8d %-15s %d\n", 
+               contactNumber(book, slot), contactName(book, slot), contactPhone(book, slot), 
+               contactEmail(book, slot), book->contacts[slot].roll_no, contactDepartment(book, slot),
+               distances[i]);
+    }
+    printf("\nFound %d close match(es).\n", found);
+}
+
+// Show the contacts whose names sound like the query
+static void soundsLikeMenu(const AddressBook *book, const char *query) {
+    int slots[PHONETIC_MAX_RESULTS];
+    int codes[MAX_POSTING_KEYS];
+    int code_count = nameSoundexCodes(query, codes);
+    int total = findContactsBySound(book, query, slots, PHONETIC_MAX_RESULTS);
+    if (total == 0) {
+        printf("No names sound like '%s'.\n", query);
+        return;
+    }
+    printf("\n=== Names Sounding Like '%s' (", query);
+    for (int c = 0; c < code_count; c++) {
+        char text[SOUNDEX_LEN];
+        formatSoundex(codes[c], text);
+        printf(c == 0 ? "%s" : " %s", text);
+    }
+    printf(") ===\n");
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    int shown = total < PHONETIC_MAX_RESULTS ? total : PHONETIC_MAX_RESULTS;
+    for (int i = 0; i < shown; i++) {
+        displayContact(book, slots[i]);
+    }
+    if (total > shown) {
+        printf("\nShowing %d of %d matches.\n", shown, total);
+    } else {
+        printf("\nFound %d contact(s).\n", total);
+    }
+}
+
+// Multi-field query: parse it, show the plan, then print the matches as the
+// iterator produces them
+static void queryMenu(const AddressBook *book) {
+    char text[512];
+    printf("Conditions: name, phone, email, roll, dept with = ^= (prefix) ~ (contains)\n");
+    printf("< <= > >= or 'between A and B', joined by 'and' / 'or'. For example:\n");
+    printf("  dept = \"Computer Science\" and name ^= A and roll between 1000 and 2000\n");
+    printf("Enter query: ");
+    if (fgets(text, sizeof(text), stdin) == NULL) {
+        return;
+    }
+    text[strcspn(text, "\n")] = 0;
     
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-        
-        if (book->contacts[mid].roll_no == roll_no) {
-            return mid;
-        } else if (book->contacts[mid].roll_no < roll_no) {
-            left = mid + 1;
+    Query query;
+    if (!parseQuery(text, &query)) {
+        return;
+    }
+    QueryIterator iterator;
+    startQuery(&iterator, book, &query);
+    printf("\n");
+    describeQueryPlan(&iterator, stdout);
+    
+    printf("\n=== Query Results ===\n");
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    Renderer renderer;
+    int buffered = initializeRenderer(&renderer, stdout);
+    ContactNumbering numbering;
+    startNumbering(&numbering, book);
+    int found = 0;
+    int slot;
+    while ((slot = nextQueryResult(&iterator)) != -1) {
+        if (buffered) {
+            renderContact(&renderer, book, slot, numberOf(&numbering, book, slot));
         } else {
-            right = mid - 1;
+            printContactRow(book, slot, numberOf(&numbering, book, slot));
         }
+        found++;
     }
-    return -1;
+    freeNumbering(&numbering);
+    if (buffered) {
+        freeRenderer(&renderer);
+    }
+    
+    if (found == 0) {
+        printf("No contacts match the query.\n");
+    } else {
+        printf("\nFound %d contact(s).\n", found);
+    }
+}
+
+// List every contact whose roll number lies between low and a second
+// number read from the user, with the count and the first and last roll
+// numbers of the range
+static void rollRangeMenu(const AddressBook *book, int low) {
+    int high;
+    printf("Enter the last roll number of the range: ");
+    if (scanf("%d", &high) != 1) {
+        getchar();
+        printf("Invalid roll number!\n");
+        return;
+    }
+    getchar();
+    if (high < low) {
+        int swap = low;
+        low = high;
+        high = swap;
+    }
+
+    int found = findContactsByRollRange(book, low, high, NULL, 0);
+    if (found == 0) {
+        int first = firstContactByRoll(book), last = lastContactByRoll(book);
+        printf("No contacts with roll numbers %d to %d (the book holds %d to %d).\n",
+               low, high, book->contacts[first].roll_no, book->contacts[last].roll_no);
+        return;
+    }
+    int *slots = malloc(found * sizeof(int));
+    if (slots == NULL) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    findContactsByRollRange(book, low, high, slots, found);
+    printf("\n=== Roll Numbers %d to %d ===\n", low, high);
+    printf("%-4s %-20s %-15s %-30s %-8s %-15s\n",
+           "No.", "Name", "Phone", "Email", "Roll No", "Department");
+    printf("================================================================================\n");
+    renderContacts(book, slots, 0, found);
+
+    // Unindexed contacts follow the ordered ones, so look at every match
+    int first = book->contacts[slots[0]].roll_no, last = first;
+    for (int i = 1; i < found; i++) {
+        int roll_no = book->contacts[slots[i]].roll_no;
+        first = roll_no < first ? roll_no : first;
+        last = roll_no > last ? roll_no : last;
+    }
+    printf("\nFound %d contact(s); first roll number %d, last %d.\n", found, first, last);
+    free(slots);
 }
 
 // Search contact menu
 void searchContactMenu(const AddressBook *book) {
-    if (book->count == 0) {
+    if (countContacts(book) == 0) {
         printf("\nNo contacts available to search.\n");
         return;
     }
@@ -326,6 +2405,7 @@ void searchContactMenu(const AddressBook *book) {
     printf("2. Search by Phone\n");
     printf("3. Search by Roll Number\n");
     printf("4. Search by Department\n");
+    printf("5. Multi-field Query (and / or, prefix, range, contains)\n");
     printf("Enter your choice: ");
     scanf("%d", &choice);
     getchar(); // Consume newline
@@ -338,14 +2418,27 @@ void searchContactMenu(const AddressBook *book) {
             
             printf("\nChoose search algorithm:\n");
             printf("1. Linear Search\n");
-            printf("2. Binary Search (will sort contacts first)\n");
+            printf("2. Binary Search (sorted name index)\n");
+            printf("3. Prefix Autocomplete (top %d from the name index)\n", NAME_AUTOCOMPLETE_RESULTS);
+            printf("4. Fuzzy Search (typo-tolerant, trigram index)\n");
+            printf("5. Sounds Like (phonetic index)\n");
             printf("Enter choice: ");
             scanf("%d", &search_type);
             getchar();
             
+            if (search_type == 5) {
+                soundsLikeMenu(book, search_term);
+                break;
+            }
+            if (search_type == 4) {
+                fuzzySearchMenu(book, search_term);
+                break;
+            }
+            if (search_type == 3) {
+                autocompleteByName(book, search_term, sizeof(search_term));
+                break;
+            }
             if (search_type == 2) {
-                printf("Sorting contacts by name for binary search...\n");
-                sortContactsByName((AddressBook *)book); // Cast away const for sorting
                 result = binarySearchByName(book, search_term);
             } else {
                 result = linearSearchByName(book, search_term);
@@ -356,7 +2449,7 @@ void searchContactMenu(const AddressBook *book) {
                 printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
                        "No.", "Name", "Phone", "Email", "Roll No", "Department");
                 printf("================================================================================\n");
-                displayContact(&book->contacts[result], result);
+                displayContact(book, result);
             } else {
                 printf("Contact with name '%s' not found.\n", search_term);
             }
@@ -367,13 +2460,48 @@ void searchContactMenu(const AddressBook *book) {
             fgets(search_term, sizeof(search_term), stdin);
             search_term[strcspn(search_term, "\n")] = 0;
             
-            result = linearSearchByPhone(book, search_term);
+            printf("\nChoose search algorithm:\n");
+            printf("1. Linear Search (exact text)\n");
+            printf("2. Phone Index (exact digits, punctuation ignored)\n");
+            printf("3. Prefix Search (phone index)\n");
+            printf("Enter choice: ");
+            scanf("%d", &search_type);
+            getchar();
+            
+            if (search_type == 3) {
+                int slots[PHONE_PREFIX_MAX_RESULTS];
+                int found = findContactsByPhonePrefix(book, search_term, slots, PHONE_PREFIX_MAX_RESULTS);
+                if (found == 0) {
+                    printf("No contacts with phone starting with '%s'.\n", search_term);
+                    break;
+                }
+                printf("\n=== Phones Starting With %s ===\n", search_term);
+                printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
+                       "No.", "Name", "Phone", "Email", "Roll No", "Department");
+                printf("================================================================================\n");
+                for (int i = 0; i < found && i < PHONE_PREFIX_MAX_RESULTS; i++) {
+                    displayContact(book, slots[i]);
+                }
+                if (found > PHONE_PREFIX_MAX_RESULTS) {
+                    printf("\nShowing %d of %d matches; type more digits to narrow the search.\n",
+                           PHONE_PREFIX_MAX_RESULTS, found);
+                } else {
+                    printf("\nFound %d contact(s).\n", found);
+                }
+                break;
+            }
+            
+            if (search_type == 2) {
+                result = findContactByPhone(book, search_term);
+            } else {
+                result = linearSearchByPhone(book, search_term);
+            }
             if (result != -1) {
                 printf("\n=== Contact Found ===\n");
                 printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
                        "No.", "Name", "Phone", "Email", "Roll No", "Department");
                 printf("================================================================================\n");
-                displayContact(&book->contacts[result], result);
+                displayContact(book, result);
             } else {
                 printf("Contact with phone '%s' not found.\n", search_term);
             }
@@ -385,18 +2513,21 @@ void searchContactMenu(const AddressBook *book) {
             getchar();
             
             printf("\nChoose search algorithm:\n");
-            printf("1. Linear Search\n");
-            printf("2. Binary Search (will sort contacts first)\n");
+            printf("1. Hash Index Lookup\n");
+            printf("2. Binary Search (sorted roll number index)\n");
+            printf("3. Range (every roll number from %d up to a second one)\n", roll_no);
             printf("Enter choice: ");
             scanf("%d", &search_type);
             getchar();
             
+            if (search_type == 3) {
+                rollRangeMenu(book, roll_no);
+                break;
+            }
             if (search_type == 2) {
-                printf("Sorting contacts by roll number for binary search...\n");
-                sortContactsByRoll((AddressBook *)book); // Cast away const for sorting
                 result = binarySearchByRoll(book, roll_no);
             } else {
-                result = linearSearchByRoll(book, roll_no);
+                result = findContactByRoll(book, roll_no);
             }
             
             if (result != -1) {
@@ -404,7 +2535,7 @@ void searchContactMenu(const AddressBook *book) {
                 printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
                        "No.", "Name", "Phone", "Email", "Roll No", "Department");
                 printf("================================================================================\n");
-                displayContact(&book->contacts[result], result);
+                displayContact(book, result);
             } else {
                 printf("Contact with roll number %d not found.\n", roll_no);
             }
@@ -418,38 +2549,226 @@ void searchContactMenu(const AddressBook *book) {
             linearSearchByDepartment(book, search_term);
             break;
             
+        case 5:
+            queryMenu(book);
+            break;
+            
         default:
             printf("Invalid choice!\n");
     }
 }
 
+// Overwrite the contact in slot, keeping every index in step
+int replaceContact(AddressBook *book, int slot, const Contact *updated) {
+    if (slot < 0 || slot >= book->count || !isLiveSlot(book, slot)) {
+        return 0;
+    }
+    Contact old;
+    getContact(book, slot, &old);
+    int name_changed = strcasecmp(old.name, updated->name) != 0;
+    int roll_changed = old.roll_no != updated->roll_no;
+    char old_digits[MAX_PHONE_LEN], new_digits[MAX_PHONE_LEN];
+    normalizePhone(old.phone, old_digits);
+    normalizePhone(updated->phone, new_digits);
+    int phone_changed = strcmp(old_digits, new_digits) != 0;
+    int indexed = slot < book->sorted_count;
+    int old_department = book->department_ids[slot];
+    int new_department = internDepartment(&book->departments, updated->department);
+    
+    // Join the new department and make room for the text first so a failed
+    // allocation changes nothing
+    if (new_department == -1 || !reserveDepartmentText(book, book->departments.count) ||
+        !reserveArena(&book->strings, contactTextSize(updated))) {
+        return 0;
+    }
+    if (new_department != old_department &&
+        !addDepartmentMember(&book->departments, new_department, slot)) {
+        return 0;
+    }
+    
+    if (name_changed) {
+        removeTrigrams(&book->name_trigrams, old.name, slot);
+        removePhonetics(&book->name_sounds, old.name, slot);
+    }
+    if (indexed && name_changed) {
+        orderRemove(book, SORT_BY_NAME, book->name_order, slot);
+    }
+    if (indexed && roll_changed) {
+        orderRemove(book, SORT_BY_ROLL, book->roll_order, slot);
+    }
+    if (indexed && phone_changed) {
+        orderRemove(book, SORT_BY_PHONE, book->phone_order, slot);
+    }
+    if (roll_changed) {
+        rollIndexRemove(book, old.roll_no);
+    }
+    
+    releaseContactText(book, slot);
+    if (new_department != old_department) {
+        removeDepartmentMember(&book->departments, old_department, slot);
+        book->department_ids[slot] = new_department;
+    }
+    storeContactText(book, slot, updated); // Space reserved above
+    if (book->layout == STORAGE_SCAN_CACHE) {
+        storeColumns(book, slot);
+    }
+    
+    if (roll_changed) {
+        rollIndexPut(book, updated->roll_no, slot);
+    }
+    if (name_changed && (!addTrigrams(&book->name_trigrams, updated->name, slot) ||
+                         !addPhonetics(&book->name_sounds, updated->name, slot))) {
+        return 0;
+    }
+    if (indexed && name_changed) {
+        orderInsert(book, SORT_BY_NAME, book->name_order, book->order_count - 1, slot);
+    }
+    if (indexed && roll_changed) {
+        orderInsert(book, SORT_BY_ROLL, book->roll_order, book->order_count - 1, slot);
+    }
+    if (indexed && phone_changed) {
+        orderInsert(book, SORT_BY_PHONE, book->phone_order, book->order_count - 1, slot);
+    }
+    notifyChange(book, CHANGE_EDIT, old.roll_no, updated);
+    if (arenaNeedsCompaction(&book->strings)) {
+        compactStrings(book);
+    }
+    return 1;
+}
+
+// Make room on the free list for one more deleted slot
+static int reserveFreeSlot(AddressBook *book) {
+    if (book->free_count == book->free_capacity) {
+        int capacity = book->free_capacity > 0 ? book->free_capacity * 2 : INITIAL_CAPACITY;
+        int *grown = realloc(book->free_slots, capacity * sizeof(int));
+        if (grown == NULL) {
+            printf("Memory allocation failed!\n");
+            return 0;
+        }
+        book->free_slots = grown;
+        book->free_capacity = capacity;
+        STATS_REALLOC(capacity * sizeof(int));
+    }
+    return 1;
+}
+
+// Remove the contact in slot, leaving a tombstone so no other slot moves
+int removeContact(AddressBook *book, int slot) {
+    STATS_START(start);
+    if (slot < 0 || slot >= book->count || !isLiveSlot(book, slot) || !reserveFreeSlot(book)) {
+        return 0;
+    }
+    Contact removed;
+    getContact(book, slot, &removed);
+    
+    rollIndexRemove(book, removed.roll_no);
+    removeDepartmentMember(&book->departments, book->department_ids[slot], slot);
+    removeTrigrams(&book->name_trigrams, removed.name, slot);
+    removePhonetics(&book->name_sounds, removed.name, slot);
+    if (slot < book->sorted_count) {
+        orderRemove(book, SORT_BY_NAME, book->name_order, slot);
+        orderRemove(book, SORT_BY_ROLL, book->roll_order, slot);
+        orderRemove(book, SORT_BY_PHONE, book->phone_order, slot);
+        book->order_count--;
+    }
+    
+    releaseContactText(book, slot);
+    memset(&book->contacts[slot], 0, sizeof(ContactRecord));
+    if (book->layout == STORAGE_SCAN_CACHE) {
+        storeColumns(book, slot);
+    }
+    book->department_ids[slot] = -1;
+    book->free_slots[book->free_count++] = slot;
+    notifyChange(book, CHANGE_DELETE, removed.roll_no, &removed);
+    
+    // Compact once tombstones make up a quarter of the slots, or the
+    // released text half of the arena
+    if (book->free_count >= TOMBSTONE_COMPACT_MIN &&
+        book->free_count * TOMBSTONE_COMPACT_RATIO > book->count) {
+        compactAddressBook(book);
+    } else if (arenaNeedsCompaction(&book->strings)) {
+        compactStrings(book);
+    }
+    STATS_STOP(STAT_DELETE, start);
+    return 1;
+}
+
+// Slide live contacts down over the tombstones and rebuild the slot-keyed
+// indexes. Slots change, so callers must not hold slots across this call.
+int compactAddressBook(AddressBook *book) {
+    if (book->free_count == 0) {
+        return 1;
+    }
+    
+    STATS_START(start);
+    int *new_slot = malloc(book->count * sizeof(int));
+    if (new_slot == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    int live = 0;
+    for (int i = 0; i < book->count; i++) {
+        if (!isLiveSlot(book, i)) {
+            new_slot[i] = -1;
+            continue;
+        }
+        new_slot[i] = live;
+        if (live != i) {
+            book->contacts[live] = book->contacts[i];
+        }
+        live++;
+    }
+    
+    // The sorted orders keep their order; only the slot numbers change
+    for (int i = 0; i < book->order_count; i++) {
+        book->name_order[i] = new_slot[book->name_order[i]];
+        book->roll_order[i] = new_slot[book->roll_order[i]];
+        book->phone_order[i] = new_slot[book->phone_order[i]];
+    }
+    int sorted = 0;
+    for (int i = 0; i < book->sorted_count; i++) {
+        sorted += new_slot[i] != -1;
+    }
+    free(new_slot);
+    book->sorted_count = sorted;
+    book->order_count = sorted;
+    book->count = live;
+    book->free_count = 0;
+    
+    int ok = rebuildColumns(book) && rebuildDepartmentIndex(book) && rebuildNameIndexes(book) &&
+             rebuildRollIndex(book);
+    STATS_STOP(STAT_COMPACT, start);
+    return ok;
+}
+
 // Edit contact
 void editContact(AddressBook *book) {
-    if (book->count == 0) {
+    int total = countContacts(book);
+    if (total == 0) {
         printf("\nNo contacts available to edit.\n");
         return;
     }
     
     listContacts(book);
     
-    int index;
-    printf("\nEnter contact number to edit (1-%d): ", book->count);
-    scanf("%d", &index);
+    int number = 0;
+    printf("\nEnter contact number to edit (1-%d): ", total);
+    scanf("%d", &number);
     getchar(); // Consume newline
     
-    if (index < 1 || index > book->count) {
+    // Numbers count live contacts, so map the number past any deleted slots
+    int index = slotOfNumber(book, number);
+    if (index == -1) {
         printf("Invalid contact number!\n");
         return;
     }
     
-    index--; // Convert to 0-based index
-    Contact *contact = &book->contacts[index];
-    
     printf("\n=== Edit Contact ===\n");
     printf("Current details:\n");
-    displayContact(contact, index);
+    displayContact(book, index);
     
     char buffer[256];
+    Contact updated;
     int choice;
     
     do {
@@ -474,7 +2793,9 @@ void editContact(AddressBook *book) {
                         printf("Invalid name! Name should contain only letters and spaces (1-49 characters).\n");
                     }
                 } while (!validateName(buffer));
-                strcpy(contact->name, buffer);
+                getContact(book, index, &updated);
+                strcpy(updated.name, buffer);
+                replaceContact(book, index, &updated);
                 printf("Name updated successfully!\n");
                 break;
                 
@@ -485,9 +2806,13 @@ void editContact(AddressBook *book) {
                     buffer[strcspn(buffer, "\n")] = 0;
                     if (!validatePhone(buffer)) {
                         printf("Invalid phone number! Must be 10-14 characters with digits and optional +, -, (), spaces.\n");
+                    } else if (!validatePhoneUnique(buffer, book, index)) {
+                        printf("Phone number is already registered to another contact!\n");
                     }
-                } while (!validatePhone(buffer));
-                strcpy(contact->phone, buffer);
+                } while (!validatePhone(buffer) || !validatePhoneUnique(buffer, book, index));
+                getContact(book, index, &updated);
+                strcpy(updated.phone, buffer);
+                replaceContact(book, index, &updated);
                 printf("Phone updated successfully!\n");
                 break;
                 
@@ -500,21 +2825,28 @@ void editContact(AddressBook *book) {
                         printf("Invalid email! Must contain @ and . in correct positions.\n");
                     }
                 } while (!validateEmail(buffer));
-                strcpy(contact->email, buffer);
+                getContact(book, index, &updated);
+                strcpy(updated.email, buffer);
+                replaceContact(book, index, &updated);
                 printf("Email updated successfully!\n");
                 break;
                 
-            case 4:
+            case 4: {
+                int new_roll;
                 do {
                     printf("Enter new roll number: ");
-                    scanf("%d", &contact->roll_no);
+                    scanf("%d", &new_roll);
                     getchar();
-                    if (!validateRollNo(contact->roll_no, book, index)) {
+                    if (!validateRollNo(new_roll, book, index)) {
                         printf("Invalid roll number! Must be positive and unique.\n");
                     }
-                } while (!validateRollNo(contact->roll_no, book, index));
+                } while (!validateRollNo(new_roll, book, index));
+                getContact(book, index, &updated);
+                updated.roll_no = new_roll;
+                replaceContact(book, index, &updated);
                 printf("Roll number updated successfully!\n");
                 break;
+            }
                 
             case 5:
                 do {
@@ -525,7 +2857,9 @@ void editContact(AddressBook *book) {
                         printf("Invalid department! Must be 1-49 characters.\n");
                     }
                 } while (strlen(buffer) == 0 || strlen(buffer) >= MAX_DEPT_LEN);
-                strcpy(contact->department, buffer);
+                getContact(book, index, &updated);
+                strcpy(updated.department, buffer);
+                replaceContact(book, index, &updated);
                 printf("Department updated successfully!\n");
                 break;
                 
@@ -541,30 +2875,31 @@ void editContact(AddressBook *book) {
 
 // Delete contact
 void deleteContact(AddressBook *book) {
-    if (book->count == 0) {
+    int total = countContacts(book);
+    if (total == 0) {
         printf("\nNo contacts available to delete.\n");
         return;
     }
     
     listContacts(book);
     
-    int index;
-    printf("\nEnter contact number to delete (1-%d): ", book->count);
-    scanf("%d", &index);
+    int number = 0;
+    printf("\nEnter contact number to delete (1-%d): ", total);
+    scanf("%d", &number);
     getchar(); // Consume newline
     
-    if (index < 1 || index > book->count) {
+    // Numbers count live contacts, so map the number past any deleted slots
+    int index = slotOfNumber(book, number);
+    if (index == -1) {
         printf("Invalid contact number!\n");
         return;
     }
     
-    index--; // Convert to 0-based index
-    
     printf("\nContact to be deleted:\n");
     printf("%-4s %-20s %-15s %-30s %-8s %-15s\n", 
            "No.", "Name", "Phone", "Email", "Roll No", "Department");
     printf("================================================================================\n");
-    displayContact(&book->contacts[index], index);
+    displayContact(book, index);
     
     char confirm;
     printf("\nAre you sure you want to delete this contact? (y/N): ");
@@ -572,11 +2907,7 @@ void deleteContact(AddressBook *book) {
     getchar(); // Consume newline
     
     if (confirm == 'y' || confirm == 'Y') {
-        // Shift all contacts after the deleted one
-        for (int i = index; i < book->count - 1; i++) {
-            book->contacts[i] = book->contacts[i + 1];
-        }
-        book->count--;
+        removeContact(book, index);
         printf("Contact deleted successfully!\n");
     } else {
         printf("Contact deletion cancelled.\n");
@@ -585,13 +2916,13 @@ void deleteContact(AddressBook *book) {
 
 // Delete all contacts
 void deleteAllContacts(AddressBook *book) {
-    if (book->count == 0) {
+    if (countContacts(book) == 0) {
         printf("\nNo contacts available to delete.\n");
         return;
     }
     
     printf("\n=== Delete All Contacts ===\n");
-    printf("Warning: This operation will permanently delete ALL %d contact(s) from Find My Student.\n", book->count);
+    printf("Warning: This operation will permanently delete ALL %d contact(s) from Find My Student.\n", countContacts(book));
     printf("This action cannot be undone!\n\n");
     
     printf("Current contacts in Find My Student:\n");
@@ -607,7 +2938,7 @@ void deleteAllContacts(AddressBook *book) {
     
     if (strcmp(confirm, "DELETE ALL") == 0) {
         // Clear all contacts
-        book->count = 0;
+        clearAddressBook(book);
         printf("\nAll contacts have been deleted successfully!\n");
         printf("Find My Student is now empty.\n");
     } else {
@@ -1,13 +1,28 @@
 #ifndef CONTACT_H
 #define CONTACT_H
 
+#include "arena.h"
+#include "department.h"
+#include "fence.h"
+#include "trigram.h"
+#include "phonetic.h"
+
 #define MAX_NAME_LEN 50
 #define MAX_PHONE_LEN 15
 #define MAX_EMAIL_LEN 100
 #define MAX_DEPT_LEN 50
 #define INITIAL_CAPACITY 10
+#define ROLL_INDEX_INITIAL_SIZE 16
+#define SORTED_INSERT_THRESHOLD 16
+#define PHONE_PREFIX_MAX_RESULTS 20
+#define NAME_AUTOCOMPLETE_RESULTS 10
+#define FUZZY_MAX_RESULTS 10
+#define PHONETIC_MAX_RESULTS 20
+#define TOMBSTONE_COMPACT_MIN 64   // Deleted slots tolerated before compaction is considered
+#define TOMBSTONE_COMPACT_RATIO 4  // ...and compaction runs once they exceed 1/ratio of slots
 
-// Contact structure definition
+// Contact structure definition (the full text of one contact: used for input,
+// files and change records; the book itself stores ContactRecords)
 typedef struct {
     char name[MAX_NAME_LEN];
     char phone[MAX_PHONE_LEN];
@@ -16,18 +31,144 @@ typedef struct {
     char department[MAX_DEPT_LEN];
 } Contact;
 
+// A stored contact: offset/length handles into the book's string arena.
+// Members of a department that spell it alike share one copy of its name.
+typedef struct {
+    unsigned int name;
+    unsigned int phone;
+    unsigned int email;
+    unsigned int department;
+    unsigned char name_len;
+    unsigned char phone_len;
+    unsigned char email_len;
+    unsigned char department_len;
+    int roll_no;                // 0 marks a deleted slot
+} ContactRecord;
+
+// Kinds of change reported to an AddressBook's change listener
+typedef enum {
+    CHANGE_ADD,
+    CHANGE_EDIT,
+    CHANGE_DELETE,
+    CHANGE_CLEAR
+} ChangeType;
+
+// Called after each change; old_roll_no identifies the contact as it was before
+typedef void (*ChangeListener)(void *context, ChangeType type, int old_roll_no, const Contact *contact);
+
+// Fields the book can be ordered by
+typedef enum {
+    SORT_BY_NAME,
+    SORT_BY_ROLL,
+    SORT_BY_PHONE               // Digits only: "+91 98765-43210" sorts as "919876543210"
+} SortField;
+
+// Roll number index bucket (slot == -1 marks an empty bucket)
+typedef struct {
+    int roll_no;
+    int slot;
+} RollIndexEntry;
+
+// Where scans read from (the row array is always the stored copy and backs
+// display, files and every index)
+typedef enum {
+    STORAGE_ROWS,               // Scan the ContactRecord array directly
+    STORAGE_SCAN_CACHE          // Scan a column cache of the scanned fields
+} ScanLayout;
+
+// Scan cache: a struct-of-arrays copy of the scanned fields: a scan reads only the field it
+// needs. Text is inlined at full width rather than held as arena handles so a
+// scan walks one contiguous column instead of following a handle per slot.
+typedef struct {
+    char (*name)[MAX_NAME_LEN];
+    char (*phone)[MAX_PHONE_LEN];
+    int *roll_no;               // Departments need no column: see department_ids
+    int capacity;
+} ContactColumns;
+
+// Outcome of each record of a bulk insert
+typedef enum {
+    INSERT_OK,
+    INSERT_INVALID,             // Name, phone, email or roll number failed validation
+    INSERT_DUPLICATE_ROLL       // Roll number already in the book or earlier in the batch
+} InsertStatus;
+
 // AddressBook structure definition
 typedef struct {
-    Contact *contacts;
-    int count;
+    ContactRecord *contacts;
+    int count;                  // Slots in use, including deleted ones (roll_no 0)
     int capacity;
+    RollIndexEntry *roll_index; // Open-addressing hash table: roll_no -> slot
+    int roll_index_size;        // Number of buckets (always a power of two)
+    int *name_order;            // Slots ordered by case-folded name, then slot
+    int *roll_order;            // Slots ordered by roll number
+    int *phone_order;           // Slots ordered by digit-normalized phone, then slot
+    int sorted_count;           // Live slots in [0, sorted_count) are covered by the orders
+    int order_count;            // Entries in each order (sorted_count minus deletions)
+    int order_capacity;         // Allocated length of each order array
+    FenceIndex roll_fences;     // Roll number at each position of roll_order, for range scans
+    int reject_duplicate_phones; // Refuse a phone number another contact already uses
+    DepartmentDictionary departments; // Interned departments with their member slots
+    int *department_ids;        // Department id of each slot
+    int department_capacity;    // Allocated length of department_ids
+    unsigned int *department_text; // Arena offset of each department's shared name
+    int department_text_capacity;
+    StringArena strings;        // Text of every contact
+    TrigramIndex name_trigrams; // Name trigram -> slots, for fuzzy search
+    PhoneticIndex name_sounds;  // Soundex code of each name token -> slots
+    ChangeListener on_change;   // Optional hook notified of every change (e.g. the journal)
+    void *change_context;
+    ScanLayout layout;          // STORAGE_SCAN_CACHE keeps columns in step with contacts
+    ContactColumns columns;
+    int *free_slots;            // Deleted slots, reused by appendContact (a stack)
+    int free_count;
+    int free_capacity;
 } AddressBook;
 
 // Function declarations for contact management
 void initializeAddressBook(AddressBook *book);
 void freeAddressBook(AddressBook *book);
+void clearAddressBook(AddressBook *book);
+int appendContact(AddressBook *book, const Contact *contact);
+int reserveAddressBook(AddressBook *book, int entries);
+int insertContacts(AddressBook *book, const Contact *contacts, int count, unsigned char *status);
+int replaceContact(AddressBook *book, int slot, const Contact *updated);
+int removeContact(AddressBook *book, int slot);
+int compactAddressBook(AddressBook *book);
+int isLiveSlot(const AddressBook *book, int slot);
+int countContacts(const AddressBook *book);
+void getContact(const AddressBook *book, int slot, Contact *contact);
+const char *contactName(const AddressBook *book, int slot);
+const char *contactPhone(const AddressBook *book, int slot);
+const char *contactEmail(const AddressBook *book, int slot);
+const char *contactDepartment(const AddressBook *book, int slot);
+int compactStrings(AddressBook *book);
+int findContactByRoll(const AddressBook *book, int roll_no);
+int rebuildRollIndex(AddressBook *book);
+int setScanLayout(AddressBook *book, ScanLayout layout);
+int findContactsByDepartment(const AddressBook *book, const char *department, const int **slots);
+int findContactByPhone(const AddressBook *book, const char *phone);
+int findContactsByPhonePrefix(const AddressBook *book, const char *prefix, int *slots, int max_slots);
+int findContactsByRollRange(const AddressBook *book, int low, int high, int *slots, int max_slots);
+int firstContactByRoll(const AddressBook *book);
+int lastContactByRoll(const AddressBook *book);
+int findContactsByNamePrefix(const AddressBook *book, const char *prefix, int *slots, int max_slots);
+int fuzzySearchByName(const AddressBook *book, const char *query, int max_distance,
+                      int *slots, int *distances, int max_results);
+int fuzzyDistanceBound(const char *query);
+int findContactsBySound(const AddressBook *book, const char *query, int *slots, int max_slots);
+int reportDuplicatePhones(const AddressBook *book);
+int restoreAddressBook(AddressBook *book, const ContactRecord *contacts, int count,
+                       const char *strings, size_t strings_size,
+                       const RollIndexEntry *roll_index, int roll_index_size,
+                       const int *name_order, const int *roll_order,
+                       const int *phone_order, int sorted_count,
+                       const int *trigram_lengths, const int *trigram_slots,
+                       const int *sound_lengths, const int *sound_slots);
 int addContact(AddressBook *book);
 void listContacts(const AddressBook *book);
+void listContactsPage(const AddressBook *book, int first, int page_size);
+void browseContacts(const AddressBook *book, int page_size);
 void searchContactMenu(const AddressBook *book);
 int linearSearchByName(const AddressBook *book, const char *name);
 int linearSearchByPhone(const AddressBook *book, const char *phone);
@@ -42,8 +183,12 @@ int validateName(const char *name);
 int validatePhone(const char *phone);
 int validateEmail(const char *email);
 int validateRollNo(int roll_no, const AddressBook *book, int exclude_index);
+int validatePhoneUnique(const char *phone, const AddressBook *book, int exclude_index);
+int normalizePhone(const char *phone, char *digits);
+int sortContactOrder(const AddressBook *book, SortField field, int *order);
+int refreshSortedIndexes(AddressBook *book);
 void sortContactsByName(AddressBook *book);
 void sortContactsByRoll(AddressBook *book);
-void displayContact(const Contact *contact, int index);
+void displayContact(const AddressBook *book, int slot);
 
 #endif // CONTACT_H
\ No newline at end of file
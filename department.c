@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include "department.h"
+
+// Case-folded FNV-1a hash of a department name
+static unsigned int hashDepartment(const char *name) {
+    unsigned int hash = 2166136261u;
+    for (; *name; name++) {
+        hash = (hash ^ (unsigned char)tolower((unsigned char)*name)) * 16777619u;
+    }
+    return hash;
+}
+
+// Set up an empty dictionary
+void initializeDepartments(DepartmentDictionary *dict) {
+    memset(dict, 0, sizeof(*dict));
+}
+
+// Free every name, posting list and the hash table
+void freeDepartments(DepartmentDictionary *dict) {
+    for (int i = 0; i < dict->count; i++) {
+        free(dict->entries[i].name);
+        freePostingList(&dict->entries[i].members);
+    }
+    free(dict->entries);
+    free(dict->buckets);
+    memset(dict, 0, sizeof(*dict));
+}
+
+// Forget every department
+void clearDepartments(DepartmentDictionary *dict) {
+    freeDepartments(dict);
+}
+
+// Look up the id of a department (case-insensitive), or -1 if never seen
+int findDepartment(const DepartmentDictionary *dict, const char *name) {
+    if (dict->bucket_count == 0) {
+        return -1;
+    }
+    unsigned int mask = (unsigned int)dict->bucket_count - 1;
+    unsigned int i = hashDepartment(name) & mask;
+    while (dict->buckets[i] != -1) {
+        if (strcasecmp(dict->entries[dict->buckets[i]].name, name) == 0) {
+            return dict->buckets[i];
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// Grow the hash table so it stays at most half full
+static int reserveDepartmentBuckets(DepartmentDictionary *dict, int entries) {
+    if (dict->bucket_count != 0 && entries * 2 <= dict->bucket_count) {
+        return 1;
+    }
+    int new_count = dict->bucket_count ? dict->bucket_count * 2 : DEPARTMENT_BUCKETS_INITIAL;
+    while (entries * 2 > new_count) {
+        new_count *= 2;
+    }
+    int *buckets = malloc(new_count * sizeof(int));
+    if (buckets == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    for (int i = 0; i < new_count; i++) {
+        buckets[i] = -1;
+    }
+    unsigned int mask = (unsigned int)new_count - 1;
+    for (int id = 0; id < dict->count; id++) {
+        unsigned int i = hashDepartment(dict->entries[id].name) & mask;
+        while (buckets[i] != -1) {
+            i = (i + 1) & mask;
+        }
+        buckets[i] = id;
+    }
+    free(dict->buckets);
+    dict->buckets = buckets;
+    dict->bucket_count = new_count;
+    return 1;
+}
+
+// Return the id of a department, adding it to the dictionary if new (-1 on failure)
+int internDepartment(DepartmentDictionary *dict, const char *name) {
+    int id = findDepartment(dict, name);
+    if (id != -1) {
+        return id;
+    }
+    if (!reserveDepartmentBuckets(dict, dict->count + 1)) {
+        return -1;
+    }
+    if (dict->count >= dict->capacity) {
+        int new_capacity = dict->capacity ? dict->capacity * 2 : 16;
+        DepartmentEntry *entries = realloc(dict->entries, new_capacity * sizeof(DepartmentEntry));
+        if (entries == NULL) {
+            printf("Memory reallocation failed!\n");
+            return -1;
+        }
+        dict->entries = entries;
+        dict->capacity = new_capacity;
+    }
+
+    size_t length = strlen(name) + 1;
+    DepartmentEntry *entry = &dict->entries[dict->count];
+    entry->name = malloc(length);
+    if (entry->name == NULL) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    memcpy(entry->name, name, length);
+    memset(&entry->members, 0, sizeof(entry->members));
+
+    unsigned int mask = (unsigned int)dict->bucket_count - 1;
+    unsigned int i = hashDepartment(name) & mask;
+    while (dict->buckets[i] != -1) {
+        i = (i + 1) & mask;
+    }
+    dict->buckets[i] = dict->count;
+    return dict->count++;
+}
+
+// Add slot to a department's posting list, keeping it sorted
+int addDepartmentMember(DepartmentDictionary *dict, int id, int slot) {
+    return postingAdd(&dict->entries[id].members, slot);
+}
+
+// Drop slot from a department's posting list
+void removeDepartmentMember(DepartmentDictionary *dict, int id, int slot) {
+    postingRemove(&dict->entries[id].members, slot);
+}
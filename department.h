@@ -0,0 +1,32 @@
+#ifndef DEPARTMENT_H
+#define DEPARTMENT_H
+
+#include "posting.h"
+
+#define DEPARTMENT_BUCKETS_INITIAL 64
+
+// One interned department and the slots of its members
+typedef struct {
+    char *name;                 // Spelling first seen (matching is case-insensitive)
+    PostingList members;        // Member slots in ascending order
+} DepartmentEntry;
+
+// Dictionary of distinct departments; a department's id is its entry index
+typedef struct {
+    DepartmentEntry *entries;
+    int count;
+    int capacity;
+    int *buckets;               // Open-addressing hash: case-folded name -> id (-1 empty)
+    int bucket_count;           // Always a power of two
+} DepartmentDictionary;
+
+// Function declarations for the department dictionary
+void initializeDepartments(DepartmentDictionary *dict);
+void freeDepartments(DepartmentDictionary *dict);
+void clearDepartments(DepartmentDictionary *dict);
+int internDepartment(DepartmentDictionary *dict, const char *name);
+int findDepartment(const DepartmentDictionary *dict, const char *name);
+int addDepartmentMember(DepartmentDictionary *dict, int id, int slot);
+void removeDepartmentMember(DepartmentDictionary *dict, int id, int slot);
+
+#endif // DEPARTMENT_H
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "fence.h"
+#include "stats.h"
+
+// Number of blocks covering count keys
+static int blockCount(int count) {
+    return (count + FENCE_STRIDE - 1) / FENCE_STRIDE;
+}
+
+// Set up an empty index (storage is allocated on first reserve)
+void initializeFenceIndex(FenceIndex *index) {
+    index->keys = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->fences = NULL;
+    index->fence_capacity = 0;
+}
+
+// Release the index's storage
+void freeFenceIndex(FenceIndex *index) {
+    free(index->keys);
+    free(index->fences);
+    initializeFenceIndex(index);
+}
+
+// Make room for at least entries keys
+int reserveFenceIndex(FenceIndex *index, int entries) {
+    if (index->capacity >= entries) {
+        return 1;
+    }
+    int *keys = realloc(index->keys, entries * sizeof(int));
+    if (keys == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    index->keys = keys;
+    index->capacity = entries;
+    int blocks = blockCount(entries);
+    int *fences = realloc(index->fences, blocks * sizeof(int));
+    if (fences == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    index->fences = fences;
+    index->fence_capacity = blocks;
+    STATS_REALLOC((entries + blocks) * sizeof(int));
+    return 1;
+}
+
+// Refresh the fences of every block from the one holding pos onwards
+static void updateFences(FenceIndex *index, int pos) {
+    int blocks = blockCount(index->count);
+    for (int b = pos / FENCE_STRIDE; b < blocks; b++) {
+        index->fences[b] = index->keys[b * FENCE_STRIDE];
+    }
+}
+
+// Insert key at position pos (the caller keeps the keys sorted; room must
+// have been reserved)
+void fenceInsert(FenceIndex *index, int pos, int key) {
+    memmove(&index->keys[pos + 1], &index->keys[pos], (index->count - pos) * sizeof(int));
+    index->keys[pos] = key;
+    index->count++;
+    updateFences(index, pos);
+}
+
+// Remove the key at position pos
+void fenceRemove(FenceIndex *index, int pos) {
+    memmove(&index->keys[pos], &index->keys[pos + 1], (index->count - pos - 1) * sizeof(int));
+    index->count--;
+    updateFences(index, pos);
+}
+
+// Adopt keys[0..count), written directly into the index, and rebuild the fences
+void rebuildFences(FenceIndex *index, int count) {
+    index->count = count;
+    updateFences(index, 0);
+}
+
+// Position of the first key that is >= key: a binary search over the fences
+// picks the block, then one over that block's keys finishes
+int fenceLowerBound(const FenceIndex *index, int key) {
+    int left = 0, right = blockCount(index->count);
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (index->fences[mid] < key) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    if (left == 0) {
+        return 0;
+    }
+
+    // Block left - 1 starts below key and block left (if any) at or above it
+    int first = (left - 1) * FENCE_STRIDE + 1;
+    int last = left * FENCE_STRIDE < index->count ? left * FENCE_STRIDE : index->count;
+    while (first < last) {
+        int mid = first + (last - first) / 2;
+        if (index->keys[mid] < key) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+// Position of the first key that is > key
+int fenceUpperBound(const FenceIndex *index, int key) {
+    return key == INT_MAX ? index->count : fenceLowerBound(index, key + 1);
+}
@@ -0,0 +1,27 @@
+#ifndef FENCE_H
+#define FENCE_H
+
+#define FENCE_STRIDE 16             // Keys per block (one 64-byte cache line of ints)
+
+// Sorted array of integer keys with fence pointers: the first key of every
+// block of FENCE_STRIDE keys is copied into a short array that a search
+// narrows first, so only one block of the full array is touched
+typedef struct {
+    int *keys;                  // Ascending
+    int count;
+    int capacity;
+    int *fences;                // fences[b] == keys[b * FENCE_STRIDE]
+    int fence_capacity;
+} FenceIndex;
+
+// Function declarations for fence-pointer indexes
+void initializeFenceIndex(FenceIndex *index);
+void freeFenceIndex(FenceIndex *index);
+int reserveFenceIndex(FenceIndex *index, int entries);
+void fenceInsert(FenceIndex *index, int pos, int key);
+void fenceRemove(FenceIndex *index, int pos);
+void rebuildFences(FenceIndex *index, int count);
+int fenceLowerBound(const FenceIndex *index, int key);
+int fenceUpperBound(const FenceIndex *index, int key);
+
+#endif // FENCE_H
@@ -1,8 +1,26 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <time.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+#define HAVE_SSE2_SCAN 1
+#include <emmintrin.h>
+#endif
 #include "file.h"
+#include "stats.h"
 
 // Check if file exists
 int fileExists(const char *filename) {
@@ -14,272 +32,1339 @@ int fileExists(const char *filename) {
     return 0;
 }
 
-// Create backup of existing file
-void createBackup(const char *filename) {
-    if (!fileExists(filename)) {
-        return;
+// Flush a stream all the way to stable storage
+static int syncFile(FILE *file) {
+    if (fflush(file) != 0) {
+        return 0;
     }
-    
-    // Generate backup filename with timestamp
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Build the timestamped backup name for filename
+static void backupPath(const char *filename, char *path, size_t size) {
     time_t now = time(NULL);
     struct tm *local_time = localtime(&now);
-    char backup_filename[256];
-    snprintf(backup_filename, sizeof(backup_filename), 
-             "%s.backup_%04d%02d%02d_%02d%02d%02d",
-             filename,
+    snprintf(path, size,
+             "%s%s%04d%02d%02d_%02d%02d%02d",
+             filename, BACKUP_SUFFIX,
              local_time->tm_year + 1900,
              local_time->tm_mon + 1,
              local_time->tm_mday,
              local_time->tm_hour,
              local_time->tm_min,
              local_time->tm_sec);
+}
+
+// Copy a file with large block reads (used where hardlinks are unavailable)
+static int copyFile(const char *source_path, const char *target_path) {
+    FILE *source = fopen(source_path, "rb");
+    FILE *target = fopen(target_path, "wb");
+    int ok = source != NULL && target != NULL;
     
-    FILE *source = fopen(filename, "r");
-    FILE *backup = fopen(backup_filename, "w");
-    
-    if (source && backup) {
-        char buffer[1024];
-        while (fgets(buffer, sizeof(buffer), source)) {
-            fputs(buffer, backup);
+    if (ok) {
+        char buffer[65536];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+            if (fwrite(buffer, 1, n, target) != n) {
+                ok = 0;
+                break;
+            }
+            STATS_COUNT(STAT_BYTES_READ, n);
+            STATS_COUNT(STAT_BYTES_WRITTEN, n);
         }
-        printf("Backup created: %s\n", backup_filename);
     }
     
     if (source) fclose(source);
-    if (backup) fclose(backup);
+    if (target && fclose(target) != 0) ok = 0;
+    return ok;
+}
+
+// Compare backup names; the timestamp suffix sorts chronologically
+static int compareBackupNames(const void *a, const void *b) {
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+// Delete all but the newest MAX_BACKUPS backups of filename
+static void pruneBackups(const char *filename) {
+    char directory[256] = ".";
+    const char *base = strrchr(filename, '/');
+    if (base != NULL) {
+        snprintf(directory, sizeof(directory), "%.*s", (int)(base - filename), filename);
+        base++;
+    } else {
+        base = filename;
+    }
+    
+    char prefix[256];
+    snprintf(prefix, sizeof(prefix), "%s%s", base, BACKUP_SUFFIX);
+    size_t prefix_len = strlen(prefix);
+    
+    DIR *dir = opendir(directory);
+    if (dir == NULL) {
+        return;
+    }
+    char **names = NULL;
+    int count = 0, capacity = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, prefix, prefix_len) != 0) {
+            continue;
+        }
+        if (count == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 16;
+            char **temp = realloc(names, new_capacity * sizeof(char *));
+            if (temp == NULL) {
+                break;
+            }
+            names = temp;
+            capacity = new_capacity;
+        }
+        names[count] = malloc(strlen(entry->d_name) + 1);
+        if (names[count] == NULL) {
+            break;
+        }
+        strcpy(names[count], entry->d_name);
+        count++;
+    }
+    closedir(dir);
+    
+    qsort(names, count, sizeof(char *), compareBackupNames);
+    for (int i = 0; i < count; i++) {
+        if (i < count - MAX_BACKUPS) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s", directory, names[i]);
+            remove(path);
+        }
+        free(names[i]);
+    }
+    free(names);
 }
 
-// Save contacts to CSV file
+// Create backup of existing file. The backup is a hardlink to the current
+// file, which is never modified in place (saves rename a new file over it),
+// so backing up costs no I/O regardless of the book's size.
+void createBackup(const char *filename) {
+    if (!fileExists(filename)) {
+        return;
+    }
+    
+    STATS_START(start);
+    char backup_filename[256];
+    backupPath(filename, backup_filename, sizeof(backup_filename));
+    remove(backup_filename); // A save earlier in the same second is superseded
+    
+    int ok = 0;
+#ifndef _WIN32
+    ok = link(filename, backup_filename) == 0;
+#endif
+    if (!ok) {
+        ok = copyFile(filename, backup_filename);
+    }
+    
+    if (ok) {
+        printf("Backup created: %s\n", backup_filename);
+        pruneBackups(filename);
+    } else {
+        printf("Warning: Unable to create backup %s.\n", backup_filename);
+    }
+    STATS_STOP(STAT_BACKUP, start);
+}
+
+// Write one quoted CSV field, doubling any embedded quotes
+static void writeCSVField(FILE *file, const char *value) {
+    fputc('"', file);
+    if (strchr(value, '"') == NULL) {
+        fputs(value, file);
+    } else {
+        for (const char *c = value; *c; c++) {
+            if (*c == '"') {
+                fputc('"', file);
+            }
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+// Write one CSV line from the fields of a contact
+static void writeCSVLine(FILE *file, const char *name, const char *phone, const char *email,
+                         int roll_no, const char *department) {
+    // Handle commas in data by enclosing in quotes
+    writeCSVField(file, name);
+    fputc(',', file);
+    writeCSVField(file, phone);
+    fputc(',', file);
+    writeCSVField(file, email);
+    fprintf(file, ",%d,", roll_no);
+    writeCSVField(file, department);
+    fputc('\n', file);
+}
+
+// Write one contact as a CSV line
+void writeContactCSV(const Contact *contact, FILE *file) {
+    writeCSVLine(file, contact->name, contact->phone, contact->email,
+                 contact->roll_no, contact->department);
+}
+
+// Write the CSV header and the contacts in slots (all contacts, in order,
+// when slots is NULL) to an open stream; returns 0 on a write error
+int writeContactsCSV(const AddressBook *book, const int *slots, int count, FILE *file) {
+    fprintf(file, "Name,Phone,Email,Roll_No,Department\n");
+    for (int i = 0; i < count; i++) {
+        int slot = slots != NULL ? slots[i] : i;
+        if (isLiveSlot(book, slot)) {
+            writeCSVLine(file, contactName(book, slot), contactPhone(book, slot), contactEmail(book, slot),
+                         book->contacts[slot].roll_no, contactDepartment(book, slot));
+        }
+    }
+    return !ferror(file);
+}
+
+// Save contacts to CSV file. The CSV is written to a temporary file and
+// renamed into place, so a failed save never truncates the existing file.
 int saveContactsToFile(const AddressBook *book, const char *filename) {
     if (book == NULL || filename == NULL) {
         printf("Error: Invalid parameters for saving contacts.\n");
         return 0;
     }
     
-    // Create backup of existing file
-    createBackup(filename);
+    STATS_START(start);
+    char temp_filename[272];
+    snprintf(temp_filename, sizeof(temp_filename), "%s.tmp", filename);
     
-    FILE *file = fopen(filename, "w");
+    FILE *file = fopen(temp_filename, "w");
     if (file == NULL) {
-        printf("Error: Unable to open file %s for writing.\n", filename);
+        printf("Error: Unable to open file %s for writing.\n", temp_filename);
         return 0;
     }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
     
-    // Write CSV header
-    fprintf(file, "Name,Phone,Email,Roll_No,Department\n");
+    int ok = writeContactsCSV(book, NULL, book->count, file) && syncFile(file);
+    long written = ftell(file);
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Error: Unable to write file %s.\n", temp_filename);
+        remove(temp_filename);
+        return 0;
+    }
     
-    // Write contact data
-    for (int i = 0; i < book->count; i++) {
-        const Contact *contact = &book->contacts[i];
-        
-        // Handle commas in data by enclosing in quotes
-        fprintf(file, "\"%s\",\"%s\",\"%s\",%d,\"%s\"\n",
-                contact->name,
-                contact->phone,
-                contact->email,
-                contact->roll_no,
-                contact->department);
+    // Create backup of existing file
+    createBackup(filename);
+    
+#ifdef _WIN32
+    remove(filename); // rename() does not replace an existing file on Windows
+#endif
+    if (rename(temp_filename, filename) != 0) {
+        printf("Error: Unable to replace %s.\n", filename);
+        remove(temp_filename);
+        return 0;
+    }
+    if (written > 0) {
+        STATS_COUNT(STAT_BYTES_WRITTEN, (unsigned long long)written);
     }
+    STATS_STOP(STAT_SAVE, start);
+    printf("Successfully saved %d contact(s) to %s\n", countContacts(book), filename);
     
+    // Refresh the snapshot so the next startup can skip CSV parsing
+    saveSnapshot(book, filename);
+    return 1;
+}
+
+// Read-only view of a whole file (memory-mapped where the platform allows)
+typedef struct {
+    const char *data;
+    size_t size;
+    int mapped;
+} MappedFile;
+
+// Map a file into memory; returns 0 if it cannot be opened
+static int mapFile(const char *filename, MappedFile *map) {
+    map->data = NULL;
+    map->size = 0;
+    map->mapped = 0;
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 0;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 1;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data != MAP_FAILED) {
+        posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+        map->data = data;
+        map->size = (size_t)st.st_size;
+        map->mapped = 1;
+        return 1;
+    }
+#endif
+    // Fall back to reading the whole file into one heap buffer
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(file);
+        return 1;
+    }
+    char *buffer = malloc((size_t)size);
+    if (buffer == NULL) {
+        fclose(file);
+        return 0;
+    }
+    map->size = fread(buffer, 1, (size_t)size, file);
+    map->data = buffer;
     fclose(file);
-    printf("Successfully saved %d contact(s) to %s\n", book->count, filename);
     return 1;
 }
 
-// Helper function to remove quotes from CSV field
-static void removeQuotes(char *str) {
-    int len = strlen(str);
-    if (len >= 2 && str[0] == '"' && str[len-1] == '"') {
-        // Remove first and last character (quotes)
-        memmove(str, str + 1, len - 1);
-        str[len - 2] = '\0';
+// Release a view created by mapFile
+static void unmapFile(MappedFile *map) {
+#ifndef _WIN32
+    if (map->mapped) {
+        munmap((void *)map->data, map->size);
+        map->data = NULL;
+        return;
+    }
+#endif
+    free((void *)map->data);
+    map->data = NULL;
+}
+
+// First ',' or '\n' in [pos, end), or end. With SSE2 16 bytes are compared
+// per step, so a typical field ends within one or two loads.
+static const char *findFieldEnd(const char *pos, const char *end) {
+#ifdef HAVE_SSE2_SCAN
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - pos >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)pos);
+        unsigned int hits = (unsigned int)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline)));
+        if (hits != 0) {
+            return pos + __builtin_ctz(hits);
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos != ',' && *pos != '\n') {
+        pos++;
+    }
+    return pos;
+}
+
+// Parse one CSV field at pos straight into dest (NULL to discard).
+// Quoted fields may contain commas, newlines and "" escapes; a trailing
+// carriage return is dropped. Returns the position of the delimiter.
+static const char *parseCSVField(const char *pos, const char *end,
+                                 char *dest, size_t size, int *newlines) {
+    size_t len = 0;
+
+    if (pos < end && *pos == '"') {
+        pos++;
+        for (;;) {
+            const char *quote = memchr(pos, '"', end - pos);
+            const char *stop = quote ? quote : end;
+            for (const char *c = memchr(pos, '\n', stop - pos); c != NULL;
+                 c = memchr(c + 1, '\n', stop - c - 1)) {
+                (*newlines)++;
+            }
+            if (dest && len < size - 1) {
+                size_t n = stop - pos;
+                if (n > size - 1 - len) {
+                    n = size - 1 - len;
+                }
+                memcpy(dest + len, pos, n);
+                len += n;
+            }
+            if (quote == NULL) {
+                pos = end; // Unterminated quote runs to end of file
+                break;
+            }
+            if (quote + 1 < end && quote[1] == '"') {
+                if (dest && len < size - 1) {
+                    dest[len++] = '"';
+                }
+                pos = quote + 2;
+                continue;
+            }
+            pos = quote + 1;
+            break;
+        }
+        // Ignore anything between the closing quote and the delimiter
+        pos = findFieldEnd(pos, end);
+    } else {
+        const char *start = pos;
+        pos = findFieldEnd(pos, end);
+        const char *stop = pos;
+        if (stop > start && stop[-1] == '\r') {
+            stop--;
+        }
+        len = stop - start;
+        if (dest && len > size - 1) {
+            len = size - 1;
+        }
+        if (dest) {
+            memcpy(dest, start, len);
+        }
+    }
+
+    if (dest) {
+        dest[len] = '\0';
     }
+    return pos;
 }
 
-// Helper function to parse CSV line
-static int parseCSVLine(char *line, Contact *contact) {
-    char *token;
+// Parse one CSV record into contact and advance *cursor past its line ending.
+// Returns 1 if all five fields were present.
+static int parseCSVRecord(const char **cursor, const char *end, Contact *contact, int *newlines) {
+    const char *pos = *cursor;
+    char roll_buffer[16];
     int field = 0;
-    
-    // Remove trailing newline
-    line[strcspn(line, "\n")] = 0;
-    
-    // Parse comma-separated values
-    token = strtok(line, ",");
-    while (token != NULL && field < 5) {
+
+    for (;;) {
         switch (field) {
-            case 0: // Name
-                removeQuotes(token);
-                strncpy(contact->name, token, MAX_NAME_LEN - 1);
-                contact->name[MAX_NAME_LEN - 1] = '\0';
-                break;
-            case 1: // Phone
-                removeQuotes(token);
-                strncpy(contact->phone, token, MAX_PHONE_LEN - 1);
-                contact->phone[MAX_PHONE_LEN - 1] = '\0';
-                break;
-            case 2: // Email
-                removeQuotes(token);
-                strncpy(contact->email, token, MAX_EMAIL_LEN - 1);
-                contact->email[MAX_EMAIL_LEN - 1] = '\0';
-                break;
-            case 3: // Roll No
-                contact->roll_no = atoi(token);
-                break;
-            case 4: // Department
-                removeQuotes(token);
-                strncpy(contact->department, token, MAX_DEPT_LEN - 1);
-                contact->department[MAX_DEPT_LEN - 1] = '\0';
-                break;
+            case 0: pos = parseCSVField(pos, end, contact->name, MAX_NAME_LEN, newlines); break;
+            case 1: pos = parseCSVField(pos, end, contact->phone, MAX_PHONE_LEN, newlines); break;
+            case 2: pos = parseCSVField(pos, end, contact->email, MAX_EMAIL_LEN, newlines); break;
+            case 3: pos = parseCSVField(pos, end, roll_buffer, sizeof(roll_buffer), newlines); break;
+            case 4: pos = parseCSVField(pos, end, contact->department, MAX_DEPT_LEN, newlines); break;
+            default: pos = parseCSVField(pos, end, NULL, 0, newlines); break; // Extra fields are ignored
         }
         field++;
-        token = strtok(NULL, ",");
+        if (pos >= end || *pos == '\n') {
+            break;
+        }
+        pos++; // Skip the comma
     }
-    
-    return (field == 5); // Return 1 if all 5 fields were parsed successfully
+
+    *cursor = pos < end ? pos + 1 : end;
+    if (field < 5) {
+        return 0;
+    }
+    contact->roll_no = atoi(roll_buffer);
+    return 1;
 }
 
-// Resize address book for loading
-static int ensureCapacity(AddressBook *book, int required_capacity) {
-    if (required_capacity <= book->capacity) {
-        return 1;
+// Parse one CSV record held in a string (e.g. a request line); fields are
+// not validated. Returns 0 if it has fewer than five fields.
+int parseContactCSV(const char *line, Contact *contact) {
+    const char *cursor = line;
+    int newlines = 0;
+    return parseCSVRecord(&cursor, line + strlen(line), contact, &newlines);
+}
+
+// Outcome of reading one line of the CSV body
+typedef enum {
+    RECORD_EMPTY,       // Blank line, silently skipped
+    RECORD_UNPARSABLE,  // Fewer than five fields
+    RECORD_OK           // Parsed; validated when the batch is inserted
+} RecordStatus;
+
+// Read the record at *cursor; *lines receives the number of physical lines
+// it spans. Validation happens when the batch is inserted.
+static RecordStatus readCSVRecord(const char **cursor, const char *end, Contact *contact, int *lines) {
+    const char *pos = *cursor;
+    *lines = 1;
+    
+    // Skip empty lines
+    if (*pos == '\n' || (*pos == '\r' && (pos + 1 == end || pos[1] == '\n'))) {
+        *cursor = pos + ((*pos == '\r' && pos + 1 < end) ? 2 : 1);
+        return RECORD_EMPTY;
     }
     
-    // Calculate new capacity (at least double current, but at least required)
-    int new_capacity = book->capacity;
-    while (new_capacity < required_capacity) {
-        new_capacity *= 2;
+    int newlines = 0;
+    int parsed = parseCSVRecord(cursor, end, contact, &newlines);
+    *lines += newlines;
+    if (!parsed) {
+        return RECORD_UNPARSABLE;
+    }
+    return RECORD_OK;
+}
+
+// Records a CSV load inserted and lines it skipped as unusable
+typedef struct {
+    int loaded;
+    int rejected;               // Unparsable, invalid or a roll number repeated in the file
+} LoadCounts;
+
+// Insert the parsed records of a batch with one insertContacts call, then
+// report the unusable ones in file order. Record i starts on line
+// line_base + lines[i]. The OK records are compacted to the front of records.
+static int commitCSVRecords(AddressBook *book, Contact *records, const unsigned char *parsed,
+                            int count, int line_base, const int *lines, LoadCounts *counts) {
+    unsigned char *status = malloc(count > 0 ? count : 1);
+    if (status == NULL) {
+        printf("Error: Memory allocation failed while loading contacts.\n");
+        return 0;
+    }
+    int accepted = 0;
+    for (int i = 0; i < count; i++) {
+        if (parsed[i] == RECORD_OK) {
+            if (accepted != i) {
+                records[accepted] = records[i];
+            }
+            accepted++;
+        }
+    }
+    int inserted = insertContacts(book, records, accepted, status);
+    if (inserted < 0) {
+        free(status);
+        return 0;
     }
     
-    Contact *temp = realloc(book->contacts, new_capacity * sizeof(Contact));
-    if (temp == NULL) {
-        printf("Error: Memory reallocation failed while loading contacts.\n");
+    for (int i = 0, k = 0; i < count; i++) {
+        if (parsed[i] != RECORD_OK) {
+            printf("Warning: Could not parse line %d, skipping.\n", line_base + lines[i]);
+        } else if (status[k++] != INSERT_OK) {
+            printf("Warning: Invalid contact data on line %d, skipping.\n", line_base + lines[i]);
+        }
+    }
+    counts->loaded += inserted;
+    counts->rejected += count - inserted;
+    free(status);
+    return 1;
+}
+
+// Parse the CSV body on the calling thread, LOAD_BATCH_SIZE records at a time
+static int loadRecordsSequential(AddressBook *book, const char *pos, const char *end,
+                                 int line_number, LoadCounts *counts) {
+    Contact *batch = malloc(LOAD_BATCH_SIZE * sizeof(Contact));
+    if (batch == NULL) {
+        printf("Error: Memory allocation failed while loading contacts.\n");
         return 0;
     }
+    unsigned char status[LOAD_BATCH_SIZE];
+    int lines_at[LOAD_BATCH_SIZE];
+    int ok = 1;
     
-    book->contacts = temp;
-    book->capacity = new_capacity;
+    while (ok && pos < end) {
+        int count = 0;
+        while (pos < end && count < LOAD_BATCH_SIZE) {
+            int lines;
+            RecordStatus record = readCSVRecord(&pos, end, &batch[count], &lines);
+            if (record != RECORD_EMPTY) {
+                status[count] = (unsigned char)record;
+                lines_at[count] = line_number;
+                count++;
+            }
+            line_number += lines;
+        }
+        ok = commitCSVRecords(book, batch, status, count, 0, lines_at, counts);
+    }
+    free(batch);
+    return ok;
+}
+
+#ifndef _WIN32
+// Records parsed by one loader thread from its slice of the file
+typedef struct {
+    const char *start;          // First byte of the chunk (a line start)
+    const char *limit;          // Records must start before this byte
+    const char *end;            // End of the file; a quoted record may run past limit
+    const char *stop;           // Where parsing actually stopped
+    Contact *contacts;
+    unsigned char *status;      // RecordStatus of each parsed record
+    int *line_offsets;          // Line of each record, relative to the chunk start
+    int count;
+    int capacity;
+    int total_lines;
+    int failed;
+} LoadChunk;
+
+// Make room for one more record in a chunk's thread-local buffers
+static int growLoadChunk(LoadChunk *chunk) {
+    if (chunk->count < chunk->capacity) {
+        return 1;
+    }
+    int new_capacity = chunk->capacity ? chunk->capacity * 2 : 1024;
+    Contact *contacts = realloc(chunk->contacts, new_capacity * sizeof(Contact));
+    if (contacts == NULL) {
+        return 0;
+    }
+    chunk->contacts = contacts;
+    unsigned char *status = realloc(chunk->status, new_capacity);
+    if (status == NULL) {
+        return 0;
+    }
+    chunk->status = status;
+    int *line_offsets = realloc(chunk->line_offsets, new_capacity * sizeof(int));
+    if (line_offsets == NULL) {
+        return 0;
+    }
+    chunk->line_offsets = line_offsets;
+    chunk->capacity = new_capacity;
     return 1;
 }
 
-// Load contacts from CSV file
-int loadContactsFromFile(AddressBook *book, const char *filename) {
+// Thread body: parse every record that starts inside the chunk
+static void *parseLoadChunk(void *arg) {
+    LoadChunk *chunk = arg;
+    const char *pos = chunk->start;
+    int line = 0;
+    
+    chunk->count = 0;
+    while (pos < chunk->limit) {
+        if (!growLoadChunk(chunk)) {
+            chunk->failed = 1;
+            break;
+        }
+        int lines;
+        RecordStatus status = readCSVRecord(&pos, chunk->end, &chunk->contacts[chunk->count], &lines);
+        if (status != RECORD_EMPTY) {
+            chunk->status[chunk->count] = (unsigned char)status;
+            chunk->line_offsets[chunk->count] = line;
+            chunk->count++;
+        }
+        line += lines;
+    }
+    chunk->stop = pos;
+    chunk->total_lines = line;
+    return NULL;
+}
+
+// Parse the CSV body on several threads, then merge the chunks in file order.
+// Chunks are cut at newlines; if a cut lands inside a quoted field the next
+// chunk's start will not match where the previous one stopped, and that
+// chunk is re-parsed from the right place, so the result always matches
+// loadRecordsSequential exactly.
+static int loadRecordsParallel(AddressBook *book, const char *pos, const char *end,
+                               int line_number, int threads, LoadCounts *counts) {
+    LoadChunk *chunks = calloc(threads, sizeof(LoadChunk));
+    pthread_t *workers = calloc(threads, sizeof(pthread_t));
+    int *started = calloc(threads, sizeof(int));
+    if (chunks == NULL || workers == NULL || started == NULL) {
+        free(chunks);
+        free(workers);
+        free(started);
+        return loadRecordsSequential(book, pos, end, line_number, counts);
+    }
+    
+    size_t slice = (size_t)(end - pos) / threads;
+    const char *chunk_start = pos;
+    for (int i = 0; i < threads; i++) {
+        const char *limit = end;
+        if (i < threads - 1) {
+            const char *newline = memchr(pos + slice * (i + 1), '\n', end - (pos + slice * (i + 1)));
+            limit = newline ? newline + 1 : end;
+        }
+        if (limit < chunk_start) {
+            limit = chunk_start;
+        }
+        chunks[i].start = chunk_start;
+        chunks[i].limit = limit;
+        chunks[i].end = end;
+        chunk_start = limit;
+        started[i] = pthread_create(&workers[i], NULL, parseLoadChunk, &chunks[i]) == 0;
+        if (!started[i]) {
+            parseLoadChunk(&chunks[i]);
+        }
+    }
+    
+    int total = 0;
+    for (int i = 0; i < threads; i++) {
+        if (started[i]) {
+            pthread_join(workers[i], NULL);
+        }
+        total += chunks[i].count;
+    }
+    
+    // Reserve once for everything the threads found
+    int ok = reserveAddressBook(book, book->count + total);
+    const char *expected = pos;
+    for (int i = 0; ok && i < threads; i++) {
+        LoadChunk *chunk = &chunks[i];
+        if (chunk->start != expected) {
+            chunk->start = expected;
+            parseLoadChunk(chunk);
+        }
+        if (chunk->failed) {
+            printf("Error: Memory allocation failed while loading contacts.\n");
+            ok = 0;
+            break;
+        }
+        ok = commitCSVRecords(book, chunk->contacts, chunk->status, chunk->count,
+                              line_number, chunk->line_offsets, counts);
+        line_number += chunk->total_lines;
+        expected = chunk->stop;
+    }
+    
+    for (int i = 0; i < threads; i++) {
+        free(chunks[i].contacts);
+        free(chunks[i].status);
+        free(chunks[i].line_offsets);
+    }
+    free(chunks);
+    free(workers);
+    free(started);
+    return ok;
+}
+#endif
+
+// Load contacts from CSV file using up to threads parser threads
+// (threads <= 0 picks one per core for large files). If rejected is not
+// NULL it receives the number of lines skipped as unusable.
+int loadContactsFromFileParallel(AddressBook *book, const char *filename, int threads, int *rejected) {
     if (book == NULL || filename == NULL) {
         printf("Error: Invalid parameters for loading contacts.\n");
         return 0;
     }
     
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
+    STATS_START(start);
+    MappedFile map;
+    if (!mapFile(filename, &map)) {
         printf("Info: File %s not found. Starting with empty address book.\n", filename);
         return 1; // Not an error - file might not exist yet
     }
     
-    char line[512];
-    int line_number = 0;
-    int loaded_count = 0;
+    const char *pos = map.data;
+    const char *end = map.data + map.size;
+    int line_number = 1;
+    LoadCounts counts = {0, 0};
     
-    // Read file line by line
-    while (fgets(line, sizeof(line), file)) {
+    // Skip header line
+    if (pos < end) {
+        const char *newline = memchr(pos, '\n', end - pos);
+        pos = newline ? newline + 1 : end;
         line_number++;
-        
-        // Skip header line
-        if (line_number == 1) {
-            continue;
+    }
+    
+#ifndef _WIN32
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = map.size >= PARALLEL_LOAD_MIN_BYTES && cores > 1 ? (int)cores : 1;
+    }
+    if (threads > MAX_LOAD_THREADS) {
+        threads = MAX_LOAD_THREADS;
+    }
+    int ok = threads > 1 && end - pos > threads
+        ? loadRecordsParallel(book, pos, end, line_number, threads, &counts)
+        : loadRecordsSequential(book, pos, end, line_number, &counts);
+#else
+    (void)threads;
+    int ok = loadRecordsSequential(book, pos, end, line_number, &counts);
+#endif
+    
+    size_t bytes = map.size;
+    unmapFile(&map);
+    if (!ok || !refreshSortedIndexes(book)) {
+        return 0;
+    }
+    STATS_COUNT(STAT_BYTES_READ, bytes);
+    STATS_STOP(STAT_LOAD, start);
+    if (rejected != NULL) {
+        *rejected = counts.rejected;
+    }
+    printf("Successfully loaded %d contact(s) from %s\n", counts.loaded, filename);
+    return 1;
+}
+
+// Load contacts from CSV file
+int loadContactsFromFile(AddressBook *book, const char *filename) {
+    return loadContactsFromFileParallel(book, filename, 0, NULL);
+}
+
+// Binary snapshot header; the payload follows in this order:
+// ContactRecord[count], RollIndexEntry[roll_index_size], int[sorted_count] x 3,
+// int[TRIGRAM_COUNT] trigram list lengths, int[trigram_slots] the lists end to end,
+// int[SOUNDEX_CODES] phonetic list lengths, int[sound_slots] the lists end to end,
+// char[strings_size] (the string arena, last so the other sections stay aligned)
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int contact_size;  // sizeof(ContactRecord) of the writer
+    long long csv_size;         // Size and mtime of the CSV this snapshot mirrors
+    long long csv_mtime;
+    int count;
+    int sorted_count;
+    int roll_index_size;
+    int reserved;
+    unsigned long long strings_size;
+    unsigned long long trigram_slots;
+    unsigned long long sound_slots;
+    unsigned long long checksum; // Over the payload sections
+} SnapshotHeader;
+
+static const char SNAPSHOT_MAGIC[8] = {'F', 'M', 'S', 'S', 'N', 'A', 'P', '\0'};
+
+// Fold a payload section into the running checksum. Four independent lanes
+// over 32-byte blocks keep the multiplies from serializing on large books.
+static unsigned long long checksumSection(unsigned long long hash, const void *data, size_t size) {
+    const unsigned long long prime = 0x100000001b3ULL;
+    const unsigned char *bytes = data;
+    unsigned long long lanes[4] = {hash, hash ^ 1, hash ^ 2, hash ^ 3};
+    size_t blocks = size / 32;
+    for (size_t i = 0; i < blocks; i++) {
+        for (int lane = 0; lane < 4; lane++) {
+            unsigned long long word;
+            memcpy(&word, bytes + i * 32 + lane * 8, 8);
+            lanes[lane] = (lanes[lane] ^ word) * prime;
         }
-        
-        // Skip empty lines
-        if (strlen(line) <= 1) {
+    }
+    hash = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+        hash = (hash ^ lanes[lane]) * prime;
+    }
+    for (size_t i = blocks * 32; i < size; i++) {
+        hash = (hash ^ bytes[i]) * prime;
+    }
+    return hash;
+}
+
+// Fold a stored posting table into the checksum: the list lengths, then
+// each list on its own, so that the writer can hash the lists where they
+// lie in memory and the reader where they lie in the file
+static unsigned long long checksumPostings(unsigned long long hash, const int *lengths, int size,
+                                           const PostingTable *table, const int *slots) {
+    hash = checksumSection(hash, lengths, (size_t)size * sizeof(int));
+    for (int i = 0; i < size; i++) {
+        if (lengths[i] == 0) {
             continue;
         }
-        
-        // Ensure we have enough capacity
-        if (!ensureCapacity(book, book->count + 1)) {
-            fclose(file);
+        const int *list = table != NULL ? table->lists[i].slots : slots;
+        hash = checksumSection(hash, list, (size_t)lengths[i] * sizeof(int));
+        slots += table != NULL ? 0 : lengths[i];
+    }
+    return hash;
+}
+
+// Write every list of a posting table end to end
+static int writePostings(FILE *file, const int *lengths, const PostingTable *table) {
+    for (int i = 0; i < table->size; i++) {
+        if (lengths[i] > 0 &&
+            fwrite(table->lists[i].slots, sizeof(int), lengths[i], file) != (size_t)lengths[i]) {
             return 0;
         }
-        
-        // Parse the line
-        Contact temp_contact;
-        if (parseCSVLine(line, &temp_contact)) {
-            // Validate the loaded contact
-            if (validateName(temp_contact.name) &&
-                validatePhone(temp_contact.phone) &&
-                validateEmail(temp_contact.email) &&
-                validateRollNo(temp_contact.roll_no, book, -1)) {
-                
-                // Add contact to address book
-                book->contacts[book->count] = temp_contact;
-                book->count++;
-                loaded_count++;
-            } else {
-                printf("Warning: Invalid contact data on line %d, skipping.\n", line_number);
-            }
-        } else {
-            printf("Warning: Could not parse line %d, skipping.\n", line_number);
+    }
+    return 1;
+}
+
+// Do the size stored list lengths add up to exactly expected slots?
+static int postingLengthsValid(const int *lengths, int size, unsigned long long expected) {
+    unsigned long long listed = 0;
+    for (int i = 0; i < size; i++) {
+        if (lengths[i] < 0) {
+            return 0;
         }
+        listed += (unsigned long long)lengths[i];
+    }
+    return listed == expected;
+}
+
+// Build the snapshot path that sits next to the CSV file
+static void snapshotPath(const char *filename, char *path, size_t size) {
+    snprintf(path, size, "%s%s", filename, SNAPSHOT_SUFFIX);
+}
+
+// Write a snapshot of the book, stamped with the current state of the CSV file
+int saveSnapshot(const AddressBook *book, const char *filename) {
+    struct stat csv_stat;
+    if (book == NULL || filename == NULL || stat(filename, &csv_stat) != 0) {
+        return 0;
     }
+    if (book->free_count > 0) {
+        return 0; // Snapshots hold compact books only
+    }
+    
+    STATS_START(start);
+    char path[256], temp_path[272];
+    snapshotPath(filename, path, sizeof(path));
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    int *trigram_lengths = malloc(TRIGRAM_COUNT * sizeof(int));
+    int *sound_lengths = malloc(SOUNDEX_CODES * sizeof(int));
+    if (trigram_lengths == NULL || sound_lengths == NULL) {
+        free(trigram_lengths);
+        free(sound_lengths);
+        return 0;
+    }
+    long long trigram_slots = postingTableLengths(&book->name_trigrams, trigram_lengths);
+    long long sound_slots = postingTableLengths(&book->name_sounds, sound_lengths);
+    
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.contact_size = sizeof(ContactRecord);
+    header.csv_size = (long long)csv_stat.st_size;
+    header.csv_mtime = (long long)csv_stat.st_mtime;
+    header.count = book->count;
+    header.sorted_count = book->sorted_count;
+    header.roll_index_size = book->roll_index_size;
+    header.strings_size = book->strings.used;
+    header.trigram_slots = (unsigned long long)trigram_slots;
+    header.sound_slots = (unsigned long long)sound_slots;
+    
+    size_t contacts_size = (size_t)book->count * sizeof(ContactRecord);
+    size_t index_size = (size_t)book->roll_index_size * sizeof(RollIndexEntry);
+    size_t order_size = (size_t)book->sorted_count * sizeof(int);
+    size_t trigram_size = TRIGRAM_COUNT * sizeof(int) + (size_t)trigram_slots * sizeof(int);
+    size_t sound_size = SOUNDEX_CODES * sizeof(int) + (size_t)sound_slots * sizeof(int);
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    hash = checksumSection(hash, book->contacts, contacts_size);
+    hash = checksumSection(hash, book->roll_index, index_size);
+    hash = checksumSection(hash, book->name_order, order_size);
+    hash = checksumSection(hash, book->roll_order, order_size);
+    hash = checksumSection(hash, book->phone_order, order_size);
+    hash = checksumPostings(hash, trigram_lengths, TRIGRAM_COUNT, &book->name_trigrams, NULL);
+    hash = checksumPostings(hash, sound_lengths, SOUNDEX_CODES, &book->name_sounds, NULL);
+    hash = checksumSection(hash, book->strings.data, book->strings.used);
+    header.checksum = hash;
     
+    FILE *file = fopen(temp_path, "wb");
+    if (file == NULL) {
+        free(trigram_lengths);
+        free(sound_lengths);
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(book->contacts, 1, contacts_size, file) == contacts_size &&
+             fwrite(book->roll_index, 1, index_size, file) == index_size &&
+             fwrite(book->name_order, 1, order_size, file) == order_size &&
+             fwrite(book->roll_order, 1, order_size, file) == order_size &&
+             fwrite(book->phone_order, 1, order_size, file) == order_size &&
+             fwrite(trigram_lengths, sizeof(int), TRIGRAM_COUNT, file) == TRIGRAM_COUNT &&
+             writePostings(file, trigram_lengths, &book->name_trigrams) &&
+             fwrite(sound_lengths, sizeof(int), SOUNDEX_CODES, file) == SOUNDEX_CODES &&
+             writePostings(file, sound_lengths, &book->name_sounds) &&
+             fwrite(book->strings.data, 1, book->strings.used, file) == book->strings.used;
+    free(trigram_lengths);
+    free(sound_lengths);
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    
+    // Rename into place so a reader never sees a half-written snapshot
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return 0;
+    }
+    STATS_COUNT(STAT_BYTES_WRITTEN, sizeof(header) + contacts_size + index_size + 3 * order_size +
+                                    trigram_size + sound_size + book->strings.used);
+    STATS_STOP(STAT_SNAPSHOT_SAVE, start);
+    return 1;
+}
+
+// Load the snapshot for filename if it is intact and still matches the CSV.
+// Returns 1 if the book was filled from it, 0 if the CSV must be parsed.
+int loadSnapshot(AddressBook *book, const char *filename) {
+    struct stat csv_stat;
+    if (book == NULL || filename == NULL || stat(filename, &csv_stat) != 0) {
+        return 0;
+    }
+    
+    STATS_START(start);
+    char path[256];
+    snapshotPath(filename, path, sizeof(path));
+    MappedFile map;
+    if (!mapFile(path, &map)) {
+        return 0;
+    }
+    
+    SnapshotHeader header;
+    int ok = map.size >= sizeof(header);
+    if (ok) {
+        memcpy(&header, map.data, sizeof(header));
+        ok = memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+             header.version == SNAPSHOT_VERSION &&
+             header.contact_size == sizeof(ContactRecord) &&
+             header.csv_size == (long long)csv_stat.st_size &&
+             header.csv_mtime == (long long)csv_stat.st_mtime &&
+             header.count >= 0 && header.roll_index_size >= 0 &&
+             header.sorted_count >= 0 && header.sorted_count <= header.count &&
+             header.strings_size > 0 && header.strings_size <= ARENA_MAX_SIZE &&
+             header.trigram_slots <= (unsigned long long)header.count * MAX_NAME_TRIGRAMS &&
+             header.sound_slots <= (unsigned long long)header.count * MAX_POSTING_KEYS;
+    }
+    if (!ok) {
+        unmapFile(&map); // Missing, stale or from another version: use the CSV
+        return 0;
+    }
+    
+    size_t contacts_size = (size_t)header.count * sizeof(ContactRecord);
+    size_t index_size = (size_t)header.roll_index_size * sizeof(RollIndexEntry);
+    size_t order_size = (size_t)header.sorted_count * sizeof(int);
+    size_t trigram_size = TRIGRAM_COUNT * sizeof(int) + (size_t)header.trigram_slots * sizeof(int);
+    size_t sound_size = SOUNDEX_CODES * sizeof(int) + (size_t)header.sound_slots * sizeof(int);
+    size_t strings_size = (size_t)header.strings_size;
+    if (map.size != sizeof(header) + contacts_size + index_size + 3 * order_size + trigram_size +
+                    sound_size + strings_size) {
+        printf("Warning: Snapshot %s is truncated, loading CSV instead.\n", path);
+        unmapFile(&map);
+        return 0;
+    }
+    
+    const char *contacts = map.data + sizeof(header);
+    const char *roll_index = contacts + contacts_size;
+    const char *name_order = roll_index + index_size;
+    const char *roll_order = name_order + order_size;
+    const char *phone_order = roll_order + order_size;
+    const int *trigram_lengths = (const int *)(phone_order + order_size);
+    const int *trigram_slots = trigram_lengths + TRIGRAM_COUNT;
+    const int *sound_lengths = (const int *)(phone_order + order_size + trigram_size);
+    const int *sound_slots = sound_lengths + SOUNDEX_CODES;
+    const char *strings = phone_order + order_size + trigram_size + sound_size;
+    
+    // The list lengths must account for exactly the stored slots before
+    // they are trusted to walk them
+    if (!postingLengthsValid(trigram_lengths, TRIGRAM_COUNT, header.trigram_slots) ||
+        !postingLengthsValid(sound_lengths, SOUNDEX_CODES, header.sound_slots)) {
+        printf("Warning: Snapshot %s is inconsistent, loading CSV instead.\n", path);
+        unmapFile(&map);
+        return 0;
+    }
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    hash = checksumSection(hash, contacts, contacts_size);
+    hash = checksumSection(hash, roll_index, index_size);
+    hash = checksumSection(hash, name_order, order_size);
+    hash = checksumSection(hash, roll_order, order_size);
+    hash = checksumSection(hash, phone_order, order_size);
+    hash = checksumPostings(hash, trigram_lengths, TRIGRAM_COUNT, NULL, trigram_slots);
+    hash = checksumPostings(hash, sound_lengths, SOUNDEX_CODES, NULL, sound_slots);
+    hash = checksumSection(hash, strings, strings_size);
+    if (hash != header.checksum) {
+        printf("Warning: Snapshot %s failed its checksum, loading CSV instead.\n", path);
+        unmapFile(&map);
+        return 0;
+    }
+    
+    ok = restoreAddressBook(book, (const ContactRecord *)contacts, header.count, strings, strings_size,
+                            (const RollIndexEntry *)roll_index, header.roll_index_size,
+                            (const int *)name_order, (const int *)roll_order,
+                            (const int *)phone_order, header.sorted_count,
+                            trigram_lengths, trigram_slots, sound_lengths, sound_slots);
+    size_t bytes = map.size;
+    unmapFile(&map);
+    if (!ok) {
+        printf("Warning: Snapshot %s is inconsistent, loading CSV instead.\n", path);
+        clearAddressBook(book);
+        return 0;
+    }
+    STATS_COUNT(STAT_BYTES_READ, bytes);
+    STATS_STOP(STAT_SNAPSHOT_LOAD, start);
+    printf("Successfully loaded %d contact(s) from %s\n", book->count, path);
+    return 1;
+}
+
+// Journal file header; fixed-size JournalRecord entries follow
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int contact_size;
+    long long csv_size;         // Stamp of the CSV the journal applies on top of
+    long long csv_mtime;
+} JournalHeader;
+
+// One journaled change (type is a ChangeType or JOURNAL_COMMIT)
+typedef struct {
+    int type;
+    int old_roll_no;
+    Contact contact;
+    unsigned int checksum;
+} JournalRecord;
+
+#define JOURNAL_COMMIT 100
+
+// Write-ahead journal of changes made since the CSV was last rewritten
+typedef struct {
+    FILE *file;
+    char path[256];
+    int records;       // Records in the file, commits included
+    int uncommitted;   // Changes appended since the last commit
+} Journal;
+
+static const char JOURNAL_MAGIC[8] = {'F', 'M', 'S', 'J', 'R', 'N', 'L', '\0'};
+static Journal journal = {NULL, "", 0, 0};
+
+// Checksum of a record, used to detect a torn write at the end of the journal
+static unsigned int journalRecordChecksum(const JournalRecord *record) {
+    const unsigned char *bytes = (const unsigned char *)record;
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(JournalRecord, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Cut a file down to size bytes
+static int truncateFile(const char *path, long long size) {
+#ifdef _WIN32
+    FILE *file = fopen(path, "r+b");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = _chsize(_fileno(file), (long)size) == 0;
     fclose(file);
-    printf("Successfully loaded %d contact(s) from %s\n", loaded_count, filename);
+    return ok;
+#else
+    return truncate(path, (off_t)size) == 0;
+#endif
+}
+
+// Append one record to the open journal
+static int appendJournalRecord(Journal *j, int type, int old_roll_no, const Contact *contact) {
+    JournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.old_roll_no = old_roll_no;
+    if (contact != NULL) {
+        record.contact = *contact;
+    }
+    record.checksum = journalRecordChecksum(&record);
+    if (fwrite(&record, sizeof(record), 1, j->file) != 1) {
+        printf("Warning: Could not append to journal %s.\n", j->path);
+        return 0;
+    }
+    STATS_COUNT(STAT_BYTES_WRITTEN, sizeof(record));
+    j->records++;
     return 1;
 }
 
-// Advanced CSV parsing function (handles quoted fields with commas)
-static int parseCSVLineAdvanced(char *line, Contact *contact) {
-    char *fields[5] = {NULL};
-    int field_count = 0;
-    char *ptr = line;
-    int in_quotes = 0;
-    char *field_start = ptr;
+// Change listener: log every add, edit and delete as it happens
+static void journalChange(void *context, ChangeType type, int old_roll_no, const Contact *contact) {
+    Journal *j = context;
+    if (appendJournalRecord(j, type, old_roll_no, contact)) {
+        j->uncommitted++;
+    }
+}
+
+// Detach the journal from the book and close it; uncommitted changes are
+// dropped the next time the journal is opened
+void closeJournal(AddressBook *book) {
+    if (book != NULL && book->change_context == &journal) {
+        book->on_change = NULL;
+        book->change_context = NULL;
+    }
+    if (journal.file != NULL) {
+        fclose(journal.file);
+        journal.file = NULL;
+    }
+    journal.records = 0;
+    journal.uncommitted = 0;
+}
+
+// Start an empty journal on top of the CSV file as it is now
+static int resetJournal(AddressBook *book, const char *filename) {
+    closeJournal(book);
     
-    // Remove trailing newline
-    line[strcspn(line, "\n")] = 0;
+    struct stat csv_stat;
+    if (stat(filename, &csv_stat) != 0) {
+        return 0; // Nothing to journal against until the CSV exists
+    }
     
-    while (*ptr && field_count < 5) {
-        if (*ptr == '"' && (ptr == field_start || *(ptr-1) == ',')) {
-            in_quotes = !in_quotes;
-            // Remove the quote by shifting the string
-            memmove(ptr, ptr + 1, strlen(ptr));
-            continue;
-        } else if (*ptr == '"' && in_quotes) {
-            in_quotes = !in_quotes;
-            // Remove the quote by shifting the string
-            memmove(ptr, ptr + 1, strlen(ptr));
+    snprintf(journal.path, sizeof(journal.path), "%s%s", filename, JOURNAL_SUFFIX);
+    journal.file = fopen(journal.path, "wb");
+    if (journal.file == NULL) {
+        printf("Warning: Unable to create journal %s.\n", journal.path);
+        return 0;
+    }
+    
+    JournalHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.contact_size = sizeof(Contact);
+    header.csv_size = (long long)csv_stat.st_size;
+    header.csv_mtime = (long long)csv_stat.st_mtime;
+    if (fwrite(&header, sizeof(header), 1, journal.file) != 1 || !syncFile(journal.file)) {
+        printf("Warning: Unable to write journal %s.\n", journal.path);
+        fclose(journal.file);
+        journal.file = NULL;
+        return 0;
+    }
+    
+    book->on_change = journalChange;
+    book->change_context = &journal;
+    return 1;
+}
+
+// Apply one replayed change to the book
+static int applyJournalRecord(AddressBook *book, const JournalRecord *record) {
+    int slot;
+    switch (record->type) {
+        case CHANGE_ADD:
+            if (!validateRollNo(record->contact.roll_no, book, -1)) {
+                return 0;
+            }
+            return appendContact(book, &record->contact);
+        case CHANGE_EDIT:
+            slot = findContactByRoll(book, record->old_roll_no);
+            if (slot == -1 || !validateRollNo(record->contact.roll_no, book, slot)) {
+                return 0;
+            }
+            return replaceContact(book, slot, &record->contact);
+        case CHANGE_DELETE:
+            return removeContact(book, findContactByRoll(book, record->old_roll_no));
+        case CHANGE_CLEAR:
+            clearAddressBook(book);
+            return 1;
+    }
+    return 0;
+}
+
+// Replay committed changes from the journal on top of the freshly loaded
+// book, drop any uncommitted tail, and keep the journal open for appends
+static int openJournal(AddressBook *book, const char *filename) {
+    closeJournal(book);
+    
+    struct stat csv_stat;
+    if (stat(filename, &csv_stat) != 0) {
+        return 0;
+    }
+    
+    char path[256];
+    snprintf(path, sizeof(path), "%s%s", filename, JOURNAL_SUFFIX);
+    MappedFile map;
+    if (!mapFile(path, &map)) {
+        return resetJournal(book, filename);
+    }
+    
+    JournalHeader header;
+    int ok = map.size >= sizeof(header);
+    if (ok) {
+        memcpy(&header, map.data, sizeof(header));
+        ok = memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) == 0 &&
+             header.version == JOURNAL_VERSION &&
+             header.contact_size == sizeof(Contact) &&
+             header.csv_size == (long long)csv_stat.st_size &&
+             header.csv_mtime == (long long)csv_stat.st_mtime;
+    }
+    if (!ok) {
+        // The CSV was rewritten (or edited by hand) after this journal began
+        if (map.size > sizeof(header)) {
+            printf("Info: Journal %s does not match %s, discarding it.\n", path, filename);
+        }
+        unmapFile(&map);
+        return resetJournal(book, filename);
+    }
+    
+    // Find the last commit; anything after it was never saved
+    size_t journal_size = map.size;
+    size_t available = (map.size - sizeof(header)) / sizeof(JournalRecord);
+    const char *records = map.data + sizeof(header);
+    long committed = 0;
+    for (size_t i = 0; i < available; i++) {
+        JournalRecord record;
+        memcpy(&record, records + i * sizeof(JournalRecord), sizeof(record));
+        if (record.checksum != journalRecordChecksum(&record)) {
+            break;
+        }
+        if (record.type == JOURNAL_COMMIT) {
+            committed = (long)i + 1;
+        }
+    }
+    
+    int applied = 0;
+    for (long i = 0; i < committed; i++) {
+        JournalRecord record;
+        memcpy(&record, records + i * sizeof(JournalRecord), sizeof(record));
+        if (record.type == JOURNAL_COMMIT) {
             continue;
-        } else if (*ptr == ',' && !in_quotes) {
-            *ptr = '\0';
-            fields[field_count] = field_start;
-            field_count++;
-            field_start = ptr + 1;
-        }
-        ptr++;
-    }
-    
-    // Add the last field
-    if (field_count < 5) {
-        fields[field_count] = field_start;
-        field_count++;
-    }
-    
-    // Parse fields into contact structure
-    if (field_count == 5) {
-        strncpy(contact->name, fields[0], MAX_NAME_LEN - 1);
-        contact->name[MAX_NAME_LEN - 1] = '\0';
-        
-        strncpy(contact->phone, fields[1], MAX_PHONE_LEN - 1);
-        contact->phone[MAX_PHONE_LEN - 1] = '\0';
-        
-        strncpy(contact->email, fields[2], MAX_EMAIL_LEN - 1);
-        contact->email[MAX_EMAIL_LEN - 1] = '\0';
-        
-        contact->roll_no = atoi(fields[3]);
-        
-        strncpy(contact->department, fields[4], MAX_DEPT_LEN - 1);
-        contact->department[MAX_DEPT_LEN - 1] = '\0';
-        
+        }
+        if (applyJournalRecord(book, &record)) {
+            applied++;
+        } else {
+            printf("Warning: Skipping journal entry %ld that no longer applies.\n", i + 1);
+        }
+    }
+    unmapFile(&map);
+    if (!refreshSortedIndexes(book)) {
+        return 0;
+    }
+    
+    long long keep = (long long)sizeof(header) + (long long)committed * (long long)sizeof(JournalRecord);
+    if ((long long)journal_size != keep && !truncateFile(path, keep)) {
+        printf("Warning: Unable to discard unsaved changes from %s.\n", path);
+        return resetJournal(book, filename);
+    }
+    
+    snprintf(journal.path, sizeof(journal.path), "%s", path);
+    journal.file = fopen(journal.path, "ab");
+    if (journal.file == NULL) {
+        printf("Warning: Unable to open journal %s.\n", journal.path);
+        return 0;
+    }
+    journal.records = (int)committed;
+    journal.uncommitted = 0;
+    book->on_change = journalChange;
+    book->change_context = &journal;
+    if (applied > 0) {
+        printf("Replayed %d saved change(s) from %s\n", applied, journal.path);
+    }
+    return 1;
+}
+
+// The journal is folded back into the CSV once it holds more than a quarter
+// of the book (and at least JOURNAL_COMPACT_MIN_RECORDS records)
+static int journalNeedsCompaction(const AddressBook *book) {
+    int limit = countContacts(book) / 4;
+    if (limit < JOURNAL_COMPACT_MIN_RECORDS) {
+        limit = JOURNAL_COMPACT_MIN_RECORDS;
+    }
+    return journal.records + 1 > limit;
+}
+
+// Save the book: commit the journal when the change set is small,
+// otherwise rewrite the CSV and start a fresh journal
+int saveAddressBook(AddressBook *book, const char *filename) {
+    if (book == NULL || filename == NULL) {
+        printf("Error: Invalid parameters for saving contacts.\n");
+        return 0;
+    }
+    
+    if (journal.file != NULL && book->change_context == &journal && !journalNeedsCompaction(book)) {
+        int changes = journal.uncommitted;
+        if (!appendJournalRecord(&journal, JOURNAL_COMMIT, 0, NULL) || !syncFile(journal.file)) {
+            printf("Error: Unable to commit journal %s.\n", journal.path);
+            return 0;
+        }
+        journal.uncommitted = 0;
+        printf("Successfully saved %d change(s) to %s\n", changes, journal.path);
         return 1;
     }
     
-    return 0;
-}
\ No newline at end of file
+    if (!compactAddressBook(book) || !saveContactsToFile(book, filename)) {
+        return 0;
+    }
+    resetJournal(book, filename);
+    return 1;
+}
+
+// Replace the book with the saved state: snapshot if current, else the CSV,
+// followed by any committed changes in the journal
+int loadAddressBook(AddressBook *book, const char *filename) {
+    if (book == NULL || filename == NULL) {
+        printf("Error: Invalid parameters for loading contacts.\n");
+        return 0;
+    }
+    
+    closeJournal(book);
+    clearAddressBook(book);
+    if (!loadSnapshot(book, filename)) {
+        if (!loadContactsFromFile(book, filename)) {
+            return 0;
+        }
+        saveSnapshot(book, filename);
+    }
+    openJournal(book, filename);
+    if (book->reject_duplicate_phones) {
+        reportDuplicatePhones(book);
+    }
+    return 1;
+}
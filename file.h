@@ -1,13 +1,33 @@
 #ifndef FILE_H
 #define FILE_H
 
+#include <stdio.h>
 #include "contact.h"
 
 #define CSV_FILENAME "contacts.csv"
+#define BACKUP_SUFFIX ".backup_"
+#define MAX_BACKUPS 5
+#define SNAPSHOT_SUFFIX ".snap"
+#define SNAPSHOT_VERSION 5
+#define PARALLEL_LOAD_MIN_BYTES (4 * 1024 * 1024)
+#define MAX_LOAD_THREADS 16
+#define LOAD_BATCH_SIZE 256
+#define JOURNAL_SUFFIX ".journal"
+#define JOURNAL_VERSION 1
+#define JOURNAL_COMPACT_MIN_RECORDS 1024
 
 // Function declarations for file operations
+void writeContactCSV(const Contact *contact, FILE *file);
+int writeContactsCSV(const AddressBook *book, const int *slots, int count, FILE *file);
 int saveContactsToFile(const AddressBook *book, const char *filename);
+int parseContactCSV(const char *line, Contact *contact);
 int loadContactsFromFile(AddressBook *book, const char *filename);
+int loadContactsFromFileParallel(AddressBook *book, const char *filename, int threads, int *rejected);
+int loadAddressBook(AddressBook *book, const char *filename);
+int saveAddressBook(AddressBook *book, const char *filename);
+void closeJournal(AddressBook *book);
+int saveSnapshot(const AddressBook *book, const char *filename);
+int loadSnapshot(AddressBook *book, const char *filename);
 void createBackup(const char *filename);
 int fileExists(const char *filename);
 
@@ -1,31 +1,65 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "command.h"
 #include "contact.h"
 #include "file.h"
 #include "populate.h"
+#include "stats.h"
 
 // Function declarations for menu functions
 void displayMainMenu();
 void displayAbout();
 void displayHelp();
+void displayStatistics();
+void dumpStatistics(void);
 int getMenuChoice();
 void pauseForUser();
 void clearScreen();
 
 // Main function
-int main() {
+int main(int argc, char *argv[]) {
     AddressBook addressBook;
     int choice;
     int running = 1;
+    int page_size = 0; // Contacts per page when listing (0 lists everything)
     
     // Initialize the address book
     initializeAddressBook(&addressBook);
     
+    // Command line options
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scan-cache") == 0) {
+            if (!setScanLayout(&addressBook, STORAGE_SCAN_CACHE)) {
+                printf("Warning: Could not build the scan cache, scanning rows.\n");
+            }
+        } else if (strcmp(argv[i], "--unique-phones") == 0) {
+            addressBook.reject_duplicate_phones = 1;
+        } else if (strcmp(argv[i], "--page-size") == 0 && i + 1 < argc) {
+            page_size = atoi(argv[++i]);
+            if (page_size <= 0) {
+                printf("Warning: Page size must be positive, listing without pages.\n");
+                page_size = 0;
+            }
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            // Collect from here on and print the totals however the program exits
+            enableStats();
+            atexit(dumpStatistics);
+        } else if (isCommand(argv[i])) {
+            // Run a single subcommand instead of the menu
+            int status = runCommand(&addressBook, argc - i, argv + i);
+            closeJournal(&addressBook);
+            freeAddressBook(&addressBook);
+            return status;
+        } else {
+            printf("Warning: Unknown option '%s' ignored.\n", argv[i]);
+        }
+    }
+    
     // Load contacts from file at startup
     printf("=== Find My Student Application ===\n");
     printf("Loading contacts from %s...\n", CSV_FILENAME);
-    loadContactsFromFile(&addressBook, CSV_FILENAME);
+    loadAddressBook(&addressBook, CSV_FILENAME);
     
     // Main program loop
     while (running) {
@@ -45,7 +79,7 @@ int main() {
                 break;
                 
             case 2:
-                listContacts(&addressBook);
+                browseContacts(&addressBook, page_size);
                 pauseForUser();
                 break;
                 
@@ -71,7 +105,7 @@ int main() {
                 
             case 7:
                 printf("\n=== Save Contacts ===\n");
-                if (saveContactsToFile(&addressBook, CSV_FILENAME)) {
+                if (saveAddressBook(&addressBook, CSV_FILENAME)) {
                     printf("All contacts have been saved successfully!\n");
                 } else {
                     printf("Failed to save contacts to file.\n");
@@ -89,10 +123,8 @@ int main() {
                 getchar(); // Consume newline
                 
                 if (confirm == 'y' || confirm == 'Y') {
-                    // Clear current contacts
-                    addressBook.count = 0;
-                    // Load from file
-                    if (loadContactsFromFile(&addressBook, CSV_FILENAME)) {
+                    // Replace current contacts with the saved state
+                    if (loadAddressBook(&addressBook, CSV_FILENAME)) {
                         printf("Contacts loaded successfully!\n");
                     } else {
                         printf("Failed to load contacts from file.\n");
@@ -118,6 +150,11 @@ int main() {
                 pauseForUser();
                 break;
                 
+            case 12:
+                displayStatistics();
+                pauseForUser();
+                break;
+                
             case 0:
                 printf("\n=== Exit Application ===\n");
                 printf("Do you want to save your contacts before exiting? (y/N): ");
@@ -125,7 +162,7 @@ int main() {
                 getchar(); // Consume newline
                 
                 if (confirm == 'y' || confirm == 'Y') {
-                    if (saveContactsToFile(&addressBook, CSV_FILENAME)) {
+                    if (saveAddressBook(&addressBook, CSV_FILENAME)) {
                         printf("Contacts saved successfully!\n");
                     } else {
                         printf("Warning: Failed to save contacts!\n");
@@ -138,7 +175,7 @@ int main() {
                 break;
                 
             default:
-                printf("\nInvalid choice! Please enter a number between 0-11.\n");
+                printf("\nInvalid choice! Please enter a number between 0-12.\n");
                 pauseForUser();
                 break;
         }
@@ -148,6 +185,7 @@ int main() {
     }
     
     // Free allocated memory
+    closeJournal(&addressBook);
     freeAddressBook(&addressBook);
     
     return 0;
@@ -170,6 +208,7 @@ void displayMainMenu() {
     printf(" 9. Add Dummy Data                                \n");
     printf("10. Help                                          \n");
     printf("11. About                                         \n");
+    printf("12. Statistics                                    \n");
     printf(" 0. Exit                                          \n");
     printf("====================================================\n");
     printf("Enter your choice: ");
@@ -205,6 +244,37 @@ int getMenuChoice() {
     return choice;
 }
 
+// Show operation timings and counters; offers to start collecting when it
+// is off, or to start over when it is on
+void displayStatistics() {
+    printStats(stdout);
+    if (stats_enabled) {
+        printf("\nReset the statistics? (y/N): ");
+    } else {
+        printf("\nStart collecting now? (y/N): ");
+    }
+    int answer = getchar();
+    int c = answer;
+    while (c != '\n' && c != EOF) {
+        c = getchar();
+    }
+    if (answer != 'y' && answer != 'Y') {
+        return;
+    }
+    if (stats_enabled) {
+        resetStats();
+        printf("Statistics reset.\n");
+    } else {
+        enableStats();
+        printf("Statistics collection started.\n");
+    }
+}
+
+// Print the statistics at exit (registered by --stats)
+void dumpStatistics(void) {
+    printStats(stderr);
+}
+
 // Pause for user input
 void pauseForUser() {
     printf("\nPress Enter to continue...");
@@ -233,19 +303,28 @@ void displayHelp() {
     printf("1. Add New Contact - Add a new student contact with name, phone, email, roll number, and department\n");
     printf("2. List All Contacts - Display all contacts in a tabular format\n");
     printf("3. Search Contacts - Search for contacts using different criteria and algorithms:\n");
-    printf("   • Search by Name (Linear or Binary Search)\n");
-    printf("   • Search by Phone Number (Linear Search)\n");
-    printf("   • Search by Roll Number (Linear or Binary Search)\n");
-    printf("   • Search by Department (Linear Search - shows all matches)\n");
+    printf("   • Search by Name (Linear Search, Binary Search, Prefix Autocomplete, Fuzzy Search or\n");
+    printf("     Sounds Like)\n");
+    printf("   • Search by Phone Number (Linear Search, Phone Index or Prefix Search)\n");
+    printf("   • Search by Roll Number (Hash Index, Binary Search or a Range of roll numbers)\n");
+    printf("   • Search by Department (Department Index - shows all matches)\n");
+    printf("   • Multi-field Query (e.g. dept = \"Computer Science\" and name ^= A and roll between 100 and 200)\n");
     printf("4. Edit Contact - Modify any field of an existing contact\n");
     printf("5. Delete Contact - Remove a contact from the address book\n");
     printf("6. Delete All Contacts - Remove ALL contacts from the address book (requires confirmation)\n");
     printf("7. Save to File - Save all contacts to contacts.csv file\n");
     printf("8. Load from File - Load contacts from contacts.csv file\n");
     printf("9. Add Dummy Data - Populate the address book with sample contacts for testing\n");
+    printf("12. Statistics - Call counts, latency percentiles and I/O totals for loads, saves,\n");
+    printf("    searches, sorts and deletes (collection starts with --stats or from this menu)\n");
     printf("\nSEARCH ALGORITHMS:\n");
     printf("• Linear Search: Searches through all contacts sequentially (works on unsorted data)\n");
-    printf("• Binary Search: Faster search that requires sorted data (automatically sorts when selected)\n");
+    printf("• Binary Search: Faster search over persistent sorted indexes (contact order is unchanged)\n");
+    printf("• Fuzzy Search: Finds misspelled names through a trigram index, ranked by edit distance\n");
+    printf("• Sounds Like: Finds names that sound alike (e.g. Jon Smyth / John Smith) through Soundex buckets\n");
+    printf("• Roll Range: Finds the ends of the range in the sorted roll index through fence pointers,\n");
+    printf("  then lists everything between them\n");
+    printf("• Query: Each clause is answered from its most selective index, then filtered\n");
     printf("\nINPUT VALIDATION:\n");
     printf("• Names: Only letters and spaces allowed (1-49 characters)\n");
     printf("• Phone: 10-14 characters with digits and optional +, -, (), spaces\n");
@@ -254,8 +333,27 @@ void displayHelp() {
     printf("• Department: 1-49 characters allowed\n");
     printf("\nFILE OPERATIONS:\n");
     printf("• Data is stored in CSV format in contacts.csv\n");
-    printf("• Automatic backup is created before saving\n");
+    printf("• Automatic backup is created before saving (the last 5 are kept)\n");
     printf("• Application loads data automatically on startup\n");
+    printf("• A binary snapshot (contacts.csv.snap) lets startup skip CSV parsing\n");
+    printf("• Saving appends only the changes to contacts.csv.journal; the CSV is\n");
+    printf("  rewritten once the journal grows large\n");
+    printf("\nSTARTUP OPTIONS:\n");
+    printf("• --scan-cache: Also keep a copy of the name, phone and roll number columns\n");
+    printf("  so scans read only the field they compare (faster searches on very large\n");
+    printf("  books, more memory; the contact records remain the stored copy)\n");
+    printf("• --unique-phones: Refuse a phone number already used by another contact\n");
+    printf("  and report existing duplicates when contacts are loaded\n");
+    printf("• --page-size <n>: List contacts n per page (Enter for the next page,\n");
+    printf("  p for the previous one, g <No.> to jump, q to stop)\n");
+    printf("• --stats: Time loads, saves, searches, sorts and deletes, and print the\n");
+    printf("  statistics to stderr when the program exits\n");
+    printf("\nCOMMAND-LINE QUERIES (no menu; CSV results on stdout):\n");
+    printf("• find --roll <number> | --dept <name> | --name <name> | --phone <number>\n");
+    printf("• find --query <query>: Combine conditions with and / or (see Multi-field Query)\n");
+    printf("• import <file.csv>: Add contacts whose roll numbers are new, then save\n");
+    printf("• export [file.csv]: Write every contact as CSV\n");
+    printf("• serve [socket]: Load once and answer FIND/ADD/DELETE requests on a Unix socket\n");
 }
 
 // Display about information
@@ -0,0 +1,115 @@
+#include <ctype.h>
+#include "phonetic.h"
+
+// Set up an empty index (the bucket table is allocated lazily)
+void initializePhonetics(PhoneticIndex *index) {
+    initializePostingTable(index, SOUNDEX_CODES);
+}
+
+// Free every bucket and the table itself
+void freePhonetics(PhoneticIndex *index) {
+    freePostingTable(index);
+}
+
+// Soundex digit of an upper-case letter: 0 for vowels (and Y), -1 for H and W
+static int soundexDigit(char c) {
+    switch (c) {
+        case 'B': case 'F': case 'P': case 'V':
+            return 1;
+        case 'C': case 'G': case 'J': case 'K': case 'Q': case 'S': case 'X': case 'Z':
+            return 2;
+        case 'D': case 'T':
+            return 3;
+        case 'L':
+            return 4;
+        case 'M': case 'N':
+            return 5;
+        case 'R':
+            return 6;
+        case 'H': case 'W':
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+// American Soundex of the letters in token[0..len), packed as
+// letter * 343 + d1 * 49 + d2 * 7 + d3
+static int soundexCode(const char *token, int len) {
+    char first = (char)toupper((unsigned char)token[0]);
+    int code = (first - 'A') * 343;
+    int weight = 49;
+    int last = soundexDigit(first);
+    for (int i = 1; i < len && weight > 0; i++) {
+        int digit = soundexDigit((char)toupper((unsigned char)token[i]));
+        if (digit == -1) {
+            continue;           // H and W do not separate equal codes
+        }
+        if (digit != 0 && digit != last) {
+            code += digit * weight;
+            weight /= 7;
+        }
+        last = digit;           // A vowel lets the next equal code count again
+    }
+    return code;
+}
+
+// Soundex codes of every letter run in name, sorted and distinct; returns how many
+int nameSoundexCodes(const char *name, int *codes) {
+    int count = 0;
+    while (*name && count < MAX_POSTING_KEYS) {
+        if (!isalpha((unsigned char)*name)) {
+            name++;
+            continue;
+        }
+        int len = 0;
+        while (isalpha((unsigned char)name[len])) {
+            len++;
+        }
+        int code = soundexCode(name, len);
+        name += len;
+        
+        int j = count;
+        while (j > 0 && codes[j - 1] > code) {
+            j--;
+        }
+        if (j > 0 && codes[j - 1] == code) {
+            continue;
+        }
+        for (int k = count; k > j; k--) {
+            codes[k] = codes[k - 1];
+        }
+        codes[j] = code;
+        count++;
+    }
+    return count;
+}
+
+// Write a packed code in its usual form, e.g. "S530"
+void formatSoundex(int code, char *text) {
+    text[0] = (char)('A' + code / 343);
+    text[1] = (char)('0' + code / 49 % 7);
+    text[2] = (char)('0' + code / 7 % 7);
+    text[3] = (char)('0' + code % 7);
+    text[4] = '\0';
+}
+
+// Index count names at once, for slots first..first+count-1. The name of
+// slot first + i is names[i].
+int bulkAddPhonetics(PhoneticIndex *index, const char *const *names, int first, int count) {
+    return postingTableBulkAdd(index, nameSoundexCodes, names, first, count);
+}
+
+// Index slot under the code of every token of name
+int addPhonetics(PhoneticIndex *index, const char *name, int slot) {
+    int codes[MAX_POSTING_KEYS];
+    int count = nameSoundexCodes(name, codes);
+    return postingTableAdd(index, codes, count, slot);
+}
+
+// Remove slot from the code of every token of name
+void removePhonetics(PhoneticIndex *index, const char *name, int slot) {
+    int codes[MAX_POSTING_KEYS];
+    int count = nameSoundexCodes(name, codes);
+    postingTableRemove(index, codes, count, slot);
+}
@@ -0,0 +1,23 @@
+#ifndef PHONETIC_H
+#define PHONETIC_H
+
+#include "posting.h"
+
+// A Soundex code is a letter followed by three digits 0-6, so it packs into
+// an integer below SOUNDEX_CODES and indexes a direct bucket table
+#define SOUNDEX_CODES (26 * 7 * 7 * 7)
+#define SOUNDEX_LEN 5           // "S530" plus terminator
+
+// Inverted index: Soundex code of a name token -> slots of the names with it
+typedef PostingTable PhoneticIndex;
+
+// Function declarations for the phonetic index
+void initializePhonetics(PhoneticIndex *index);
+void freePhonetics(PhoneticIndex *index);
+int nameSoundexCodes(const char *name, int *codes);
+void formatSoundex(int code, char *text);
+int addPhonetics(PhoneticIndex *index, const char *name, int slot);
+int bulkAddPhonetics(PhoneticIndex *index, const char *const *names, int first, int count);
+void removePhonetics(PhoneticIndex *index, const char *name, int slot);
+
+#endif // PHONETIC_H
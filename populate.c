@@ -1,8 +1,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include "populate.h"
 
+// Explain why a sample contact was not inserted
+static void reportRejectedSample(const Contact *contact, InsertStatus status) {
+    if (status == INSERT_DUPLICATE_ROLL) {
+        printf("Warning: Roll number %d already exists, skipping contact %s.\n",
+               contact->roll_no, contact->name);
+    } else {
+        printf("Warning: Invalid dummy data for contact %s, skipping.\n", contact->name);
+    }
+}
+
 // Add contact directly without user input (for populating dummy data)
 int addContactDirect(AddressBook *book, const char *name, const char *phone, 
                     const char *email, int roll_no, const char *department) {
@@ -10,35 +21,39 @@ int addContactDirect(AddressBook *book, const char *name, const char *phone,
         return 0;
     }
     
-    // Check if we need to resize the address book
-    if (book->count >= book->capacity) {
-        int new_capacity = book->capacity * 2;
-        Contact *temp = realloc(book->contacts, new_capacity * sizeof(Contact));
-        if (temp == NULL) {
-            printf("Memory reallocation failed while adding dummy contact!\n");
-            return 0;
-        }
-        book->contacts = temp;
-        book->capacity = new_capacity;
-    }
+    Contact new_contact;
+    snprintf(new_contact.name, sizeof(new_contact.name), "%s", name);
+    snprintf(new_contact.phone, sizeof(new_contact.phone), "%s", phone);
+    snprintf(new_contact.email, sizeof(new_contact.email), "%s", email);
+    new_contact.roll_no = roll_no;
+    snprintf(new_contact.department, sizeof(new_contact.department), "%s", department);
     
-    // Validate the contact data
-    if (!validateName(name) || !validatePhone(phone) || !validateEmail(email) || 
-        !validateRollNo(roll_no, book, -1)) {
-        printf("Warning: Invalid dummy data for contact %s, skipping.\n", name);
+    unsigned char status;
+    int added = insertContacts(book, &new_contact, 1, &status);
+    if (added == 0) {
+        reportRejectedSample(&new_contact, (InsertStatus)status);
+    }
+    return added == 1;
+}
+
+// Insert a table of sample contacts as one batch; returns how many were added
+static int insertSampleContacts(AddressBook *book, const Contact *contacts, int count) {
+    unsigned char *status = malloc(count);
+    if (status == NULL) {
+        printf("Memory allocation failed while adding dummy contacts!\n");
         return 0;
     }
-    
-    // Add the contact
-    Contact *new_contact = &book->contacts[book->count];
-    strcpy(new_contact->name, name);
-    strcpy(new_contact->phone, phone);
-    strcpy(new_contact->email, email);
-    new_contact->roll_no = roll_no;
-    strcpy(new_contact->department, department);
-    
-    book->count++;
-    return 1;
+    int added = insertContacts(book, contacts, count, status);
+    if (added >= 0) {
+        for (int i = 0; i < count; i++) {
+            if (status[i] != INSERT_OK) {
+                reportRejectedSample(&contacts[i], (InsertStatus)status[i]);
+            }
+        }
+    }
+    free(status);
+    refreshSortedIndexes(book);
+    return added > 0 ? added : 0;
 }
 
 // Populate address book with dummy contacts
@@ -46,13 +61,7 @@ void populateDummyContacts(AddressBook *book) {
     printf("\n=== Populating Address Book with Dummy Data ===\n");
     
     // Define dummy contacts data
-    struct {
-        const char *name;
-        const char *phone;
-        const char *email;
-        int roll_no;
-        const char *department;
-    } dummy_contacts[] = {
+    static const Contact dummy_contacts[] = {
         {"Alice Johnson", "1234567890", "alice.johnson@email.com", 101, "Computer Science"},
         {"Bob Smith", "2345678901", "bob.smith@email.com", 102, "Mechanical Engineering"},
         {"Carol Williams", "3456789012", "carol.williams@email.com", 103, "Electrical Engineering"},
@@ -76,19 +85,7 @@ void populateDummyContacts(AddressBook *book) {
     };
     
     int total_contacts = sizeof(dummy_contacts) / sizeof(dummy_contacts[0]);
-    int added_count = 0;
-    
-    // Add each dummy contact
-    for (int i = 0; i < total_contacts; i++) {
-        if (addContactDirect(book, 
-                           dummy_contacts[i].name,
-                           dummy_contacts[i].phone,
-                           dummy_contacts[i].email,
-                           dummy_contacts[i].roll_no,
-                           dummy_contacts[i].department)) {
-            added_count++;
-        }
-    }
+    int added_count = insertSampleContacts(book, dummy_contacts, total_contacts);
     
     printf("Successfully added %d dummy contacts to the address book.\n", added_count);
     
@@ -109,13 +106,7 @@ void populateTestContacts(AddressBook *book) {
     printf("\n=== Adding Test Contacts for Search Algorithm Testing ===\n");
     
     // Contacts designed to test search algorithms
-    struct {
-        const char *name;
-        const char *phone;
-        const char *email;
-        int roll_no;
-        const char *department;
-    } test_contacts[] = {
+    static const Contact test_contacts[] = {
         // Sorted names for binary search testing
         {"Aaron Adams", "1000000001", "aaron.adams@test.com", 1001, "Test Department"},
         {"Betty Brown", "1000000002", "betty.brown@test.com", 1002, "Test Department"},
@@ -129,19 +120,7 @@ void populateTestContacts(AddressBook *book) {
     };
     
     int total_test_contacts = sizeof(test_contacts) / sizeof(test_contacts[0]);
-    int added_count = 0;
-    
-    // Add each test contact
-    for (int i = 0; i < total_test_contacts; i++) {
-        if (addContactDirect(book, 
-                           test_contacts[i].name,
-                           test_contacts[i].phone,
-                           test_contacts[i].email,
-                           test_contacts[i].roll_no,
-                           test_contacts[i].department)) {
-            added_count++;
-        }
-    }
+    int added_count = insertSampleContacts(book, test_contacts, total_test_contacts);
     
     printf("Successfully added %d test contacts for algorithm testing.\n", added_count);
     
@@ -151,4 +130,123 @@ void populateTestContacts(AddressBook *book) {
         printf("- Multiple contacts in 'Testing' department\n");
         printf("- Sequential roll numbers for binary search testing\n");
     }
-}
\ No newline at end of file
+}
+
+// Name and department tables for generated rosters, most common first
+static const char *const roster_first_names[] = {
+    "James", "Mary", "Mohammed", "Priya", "John", "Maria", "Wei", "Aisha",
+    "Robert", "Fatima", "Michael", "Ananya", "David", "Sofia", "Rahul", "Emma",
+    "William", "Olivia", "Carlos", "Yuki", "Daniel", "Chloe", "Arjun", "Grace",
+    "Joseph", "Hannah", "Ahmed", "Isabella", "Thomas", "Mei", "Luis", "Zara",
+    "Samuel", "Amelia", "Kenji", "Leila", "Nathan", "Ingrid", "Omar", "Lucia",
+    "Ethan", "Nadia", "Felix", "Tara", "Hugo", "Elif", "Mateo", "Freya"
+};
+
+static const char *const roster_last_names[] = {
+    "Smith", "Kumar", "Wang", "Garcia", "Johnson", "Khan", "Li", "Martinez",
+    "Brown", "Singh", "Zhang", "Rodriguez", "Williams", "Patel", "Chen", "Lopez",
+    "Jones", "Sharma", "Liu", "Hernandez", "Miller", "Ali", "Yang", "Gonzalez",
+    "Davis", "Gupta", "Huang", "Perez", "Wilson", "Ahmed", "Zhao", "Sanchez",
+    "Anderson", "Reddy", "Wu", "Ramirez", "Taylor", "Hussain", "Zhou", "Torres",
+    "Thomas", "Iyer", "Xu", "Flores", "Moore", "Nair", "Sun", "Rivera"
+};
+
+// Departments with their share of students, in percent
+static const struct {
+    const char *name;
+    int weight;
+} roster_departments[] = {
+    {"Computer Science", 22}, {"Mechanical Engineering", 14}, {"Electrical Engineering", 12},
+    {"Civil Engineering", 10}, {"Business Administration", 9}, {"Mathematics", 7},
+    {"Physics", 6}, {"Chemistry", 5}, {"Biology", 5}, {"Economics", 4},
+    {"Architecture", 3}, {"Music", 2}, {"Philosophy", 1}
+};
+
+// Next 31 bits from the generator (64-bit LCG, high bits only)
+static unsigned int rosterRandom(RosterGenerator *generator) {
+    generator->state = generator->state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(generator->state >> 33);
+}
+
+// Index in [0, n) skewed towards 0: the square of a uniform draw, so the
+// first entries of a table are picked far more often than the last
+static int rosterSkewedIndex(RosterGenerator *generator, int n) {
+    double r = rosterRandom(generator) / 2147483648.0;
+    return (int)(r * r * n);
+}
+
+// Start a roster; the same seed always yields the same students
+void initializeRoster(RosterGenerator *generator, unsigned int seed) {
+    generator->state = seed * 0x9e3779b97f4a7c15ULL + 1;
+    generator->seed = seed;
+    generator->generated = 0;
+}
+
+// Produce the next student. Every student is valid, roll numbers run from 1
+// and phone numbers are distinct (for the first billion students).
+void generateStudent(RosterGenerator *generator, Contact *contact) {
+    int first_count = sizeof(roster_first_names) / sizeof(roster_first_names[0]);
+    int last_count = sizeof(roster_last_names) / sizeof(roster_last_names[0]);
+    int department_count = sizeof(roster_departments) / sizeof(roster_departments[0]);
+    const char *first = roster_first_names[rosterSkewedIndex(generator, first_count)];
+    const char *last = roster_last_names[rosterSkewedIndex(generator, last_count)];
+    
+    memset(contact, 0, sizeof(*contact));
+    contact->roll_no = ++generator->generated;
+    if (rosterRandom(generator) % 4 == 0) {
+        snprintf(contact->name, sizeof(contact->name), "%s %c %s",
+                 first, 'A' + rosterRandom(generator) % 26, last);
+    } else {
+        snprintf(contact->name, sizeof(contact->name), "%s %s", first, last);
+    }
+    
+    // 3^18 is coprime with 10^9, so this permutes the first billion indexes
+    unsigned long long mixed = ((unsigned long long)contact->roll_no * 387420489ULL + generator->seed) % 1000000000ULL;
+    snprintf(contact->phone, sizeof(contact->phone), "9%09llu", mixed);
+    
+    snprintf(contact->email, sizeof(contact->email), "%s.%s%d@university.edu",
+             first, last, contact->roll_no);
+    for (char *c = contact->email; *c; c++) {
+        *c = (char)tolower((unsigned char)*c);
+    }
+    
+    int pick = rosterRandom(generator) % 100;
+    int d = 0;
+    while (d < department_count - 1 && pick >= roster_departments[d].weight) {
+        pick -= roster_departments[d].weight;
+        d++;
+    }
+    snprintf(contact->department, sizeof(contact->department), "%s", roster_departments[d].name);
+}
+
+// Add count generated students (roll numbers 1..count) in bulk batches;
+// returns how many were added
+int populateGeneratedContacts(AddressBook *book, int count, unsigned int seed) {
+    Contact *batch = malloc(ROSTER_BATCH_SIZE * sizeof(Contact));
+    unsigned char *status = malloc(ROSTER_BATCH_SIZE);
+    if (batch == NULL || status == NULL) {
+        printf("Memory allocation failed while generating contacts!\n");
+        free(batch);
+        free(status);
+        return 0;
+    }
+    
+    RosterGenerator generator;
+    initializeRoster(&generator, seed);
+    int added = 0;
+    while (generator.generated < count) {
+        int n = count - generator.generated < ROSTER_BATCH_SIZE ? count - generator.generated : ROSTER_BATCH_SIZE;
+        for (int i = 0; i < n; i++) {
+            generateStudent(&generator, &batch[i]);
+        }
+        int inserted = insertContacts(book, batch, n, status);
+        if (inserted < 0) {
+            break;
+        }
+        added += inserted;
+    }
+    free(batch);
+    free(status);
+    refreshSortedIndexes(book);
+    return added;
+}
@@ -3,9 +3,24 @@
 
 #include "contact.h"
 
+#define ROSTER_BATCH_SIZE 4096
+#define ROSTER_DEFAULT_SEED 2024
+#define ROSTER_MAX_SIZE 10000000     // Largest roster the generate command writes
+
+// Seeded generator of synthetic students: the same seed always yields the
+// same roster, with skewed name and department frequencies
+typedef struct {
+    unsigned long long state;
+    unsigned int seed;
+    int generated;              // Students produced so far (the next roll number - 1)
+} RosterGenerator;
+
 // Function declarations for dummy data population
 void populateDummyContacts(AddressBook *book);
 int addContactDirect(AddressBook *book, const char *name, const char *phone, 
                     const char *email, int roll_no, const char *department);
+void initializeRoster(RosterGenerator *generator, unsigned int seed);
+void generateStudent(RosterGenerator *generator, Contact *contact);
+int populateGeneratedContacts(AddressBook *book, int count, unsigned int seed);
 
 #endif // POPULATE_H
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "posting.h"
+
+// Release a posting list's storage
+void freePostingList(PostingList *list) {
+    free(list->slots);
+    list->slots = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+// First position whose slot is >= slot
+static int postingLowerBound(const PostingList *list, int slot) {
+    int left = 0, right = list->count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (list->slots[mid] < slot) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Add slot, keeping the list sorted
+int postingAdd(PostingList *list, int slot) {
+    if (list->count >= list->capacity) {
+        int new_capacity = list->capacity ? list->capacity * 2 : 4;
+        int *slots = realloc(list->slots, new_capacity * sizeof(int));
+        if (slots == NULL) {
+            printf("Memory reallocation failed!\n");
+            return 0;
+        }
+        list->slots = slots;
+        list->capacity = new_capacity;
+    }
+
+    // Appends arrive in slot order, so this is usually the end of the list
+    int pos = list->count;
+    if (pos > 0 && list->slots[pos - 1] > slot) {
+        pos = postingLowerBound(list, slot);
+        memmove(&list->slots[pos + 1], &list->slots[pos], (list->count - pos) * sizeof(int));
+    }
+    list->slots[pos] = slot;
+    list->count++;
+    return 1;
+}
+
+// Drop slot if present
+void postingRemove(PostingList *list, int slot) {
+    int pos = postingLowerBound(list, slot);
+    if (pos < list->count && list->slots[pos] == slot) {
+        memmove(&list->slots[pos], &list->slots[pos + 1], (list->count - pos - 1) * sizeof(int));
+        list->count--;
+    }
+}
+
+// Set up an empty table of size lists (allocated lazily)
+void initializePostingTable(PostingTable *table, int size) {
+    table->lists = NULL;
+    table->size = size;
+}
+
+// Free every list; the table can be reused afterwards
+void freePostingTable(PostingTable *table) {
+    if (table->lists == NULL) {
+        return;
+    }
+    for (int i = 0; i < table->size; i++) {
+        freePostingList(&table->lists[i]);
+    }
+    free(table->lists);
+    table->lists = NULL;
+}
+
+// Allocate the lists on first use
+static int ensurePostingTable(PostingTable *table) {
+    if (table->lists == NULL) {
+        table->lists = calloc(table->size, sizeof(PostingList));
+        if (table->lists == NULL) {
+            printf("Memory allocation failed!\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// File slot under each of count distinct keys
+int postingTableAdd(PostingTable *table, const int *keys, int count, int slot) {
+    if (!ensurePostingTable(table)) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!postingAdd(&table->lists[keys[i]], slot)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Remove slot from each of count keys
+void postingTableRemove(PostingTable *table, const int *keys, int count, int slot) {
+    if (table->lists == NULL) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        postingRemove(&table->lists[keys[i]], slot);
+    }
+}
+
+// Index count texts at once, for slots first..first+count-1. The text of
+// slot first + i is texts[i].
+// Every list is sized exactly in a counting pass before it is filled.
+int postingTableBulkAdd(PostingTable *table, PostingKeys keys_of, const char *const *texts,
+                        int first, int count) {
+    if (!ensurePostingTable(table)) {
+        return 0;
+    }
+    int *extra = calloc(table->size, sizeof(int));
+    if (extra == NULL) {
+        printf("Memory allocation failed!\n");
+        return 0;
+    }
+    int keys[MAX_POSTING_KEYS];
+    for (int i = 0; i < count; i++) {
+        int n = keys_of(texts[i], keys);
+        for (int k = 0; k < n; k++) {
+            extra[keys[k]]++;
+        }
+    }
+    for (int t = 0; t < table->size; t++) {
+        PostingList *list = &table->lists[t];
+        if (extra[t] > 0 && list->count + extra[t] > list->capacity) {
+            int *slots = realloc(list->slots, (list->count + extra[t]) * sizeof(int));
+            if (slots == NULL) {
+                printf("Memory reallocation failed!\n");
+                free(extra);
+                return 0;
+            }
+            list->slots = slots;
+            list->capacity = list->count + extra[t];
+        }
+    }
+    free(extra);
+    for (int i = 0; i < count; i++) {
+        int n = keys_of(texts[i], keys);
+        for (int k = 0; k < n; k++) {
+            postingAdd(&table->lists[keys[k]], first + i); // Capacity reserved above
+        }
+    }
+    return 1;
+}
+
+// Write the length of every list into lengths[0..size); returns their sum
+long long postingTableLengths(const PostingTable *table, int *lengths) {
+    long long total = 0;
+    for (int i = 0; i < table->size; i++) {
+        lengths[i] = table->lists != NULL ? table->lists[i].count : 0;
+        total += lengths[i];
+    }
+    return total;
+}
+
+// Fill an empty table from stored lists: lengths[0..size) and the slots of
+// every list laid end to end. Each list must ascend and stay below
+// slot_limit; returns 0 if one does not or memory runs out.
+int loadPostingTable(PostingTable *table, const int *lengths, const int *slots, int slot_limit) {
+    if (!ensurePostingTable(table)) {
+        return 0;
+    }
+    for (int i = 0; i < table->size; i++) {
+        int count = lengths[i];
+        if (count == 0) {
+            continue;
+        }
+        for (int j = 0; j < count; j++) {
+            if (slots[j] < 0 || slots[j] >= slot_limit || (j > 0 && slots[j] <= slots[j - 1])) {
+                return 0;
+            }
+        }
+        PostingList *list = &table->lists[i];
+        list->slots = malloc(count * sizeof(int));
+        if (list->slots == NULL) {
+            printf("Memory allocation failed!\n");
+            return 0;
+        }
+        memcpy(list->slots, slots, count * sizeof(int));
+        list->count = count;
+        list->capacity = count;
+        slots += count;
+    }
+    return 1;
+}
@@ -0,0 +1,36 @@
+#ifndef POSTING_H
+#define POSTING_H
+
+#define MAX_POSTING_KEYS 64
+
+// Sorted list of contact slots, shared by the department, trigram and
+// phonetic indexes
+typedef struct {
+    int *slots;                 // Ascending slot numbers
+    int count;
+    int capacity;
+} PostingList;
+
+// Fixed number of posting lists addressed by a small integer key
+typedef struct {
+    PostingList *lists;         // size lists, allocated on first insert
+    int size;
+} PostingTable;
+
+// Writes the distinct keys of a text (at most MAX_POSTING_KEYS); returns how many
+typedef int (*PostingKeys)(const char *text, int *keys);
+
+// Function declarations for posting lists
+void freePostingList(PostingList *list);
+int postingAdd(PostingList *list, int slot);
+void postingRemove(PostingList *list, int slot);
+void initializePostingTable(PostingTable *table, int size);
+void freePostingTable(PostingTable *table);
+int postingTableAdd(PostingTable *table, const int *keys, int count, int slot);
+void postingTableRemove(PostingTable *table, const int *keys, int count, int slot);
+int postingTableBulkAdd(PostingTable *table, PostingKeys keys_of, const char *const *texts,
+                        int first, int count);
+long long postingTableLengths(const PostingTable *table, int *lengths);
+int loadPostingTable(PostingTable *table, const int *lengths, const int *slots, int slot_limit);
+
+#endif // POSTING_H
@@ -0,0 +1,549 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <limits.h>
+#include "query.h"
+
+// Query syntax: clauses joined by "or", each a list of predicates joined by
+// "and" ("and" binds tighter). A predicate is <field> <op> <value> with
+// fields name, phone, email, roll and dept, and ops = (equal), ^= (prefix),
+// ~ (contains), <, <=, >, >= and "between <low> and <high>". Values with
+// spaces or operator characters go in double quotes. For example:
+//   dept = "Computer Science" and name ^= A and roll between 1000 and 2000
+
+// Token kinds
+typedef enum {
+    TOKEN_END,
+    TOKEN_WORD,
+    TOKEN_OPERATOR,
+    TOKEN_ERROR
+} TokenType;
+
+typedef struct {
+    const char *pos;
+    TokenType type;
+    int quoted;                 // The word came from a quoted string
+    char text[QUERY_MAX_TEXT];
+} QueryLexer;
+
+static const char *field_names[] = {"name", "phone", "email", "roll", "dept"};
+
+// Characters that end a bare word
+static int isOperatorChar(char c) {
+    return c == '=' || c == '^' || c == '~' || c == '<' || c == '>' || c == '"';
+}
+
+// Read the next token into lexer->text
+static TokenType nextToken(QueryLexer *lexer) {
+    const char *pos = lexer->pos;
+    size_t length = 0;
+    while (isspace((unsigned char)*pos)) {
+        pos++;
+    }
+    lexer->quoted = 0;
+    lexer->type = TOKEN_ERROR;
+
+    if (*pos == '\0') {
+        lexer->type = TOKEN_END;
+    } else if (*pos == '"') {
+        const char *close = strchr(pos + 1, '"');
+        if (close == NULL) {
+            printf("Error: Missing closing quote in query.\n");
+        } else if ((size_t)(close - pos - 1) >= QUERY_MAX_TEXT) {
+            printf("Error: Query value is too long.\n");
+        } else {
+            length = close - pos - 1;
+            memcpy(lexer->text, pos + 1, length);
+            lexer->quoted = 1;
+            lexer->type = TOKEN_WORD;
+            pos = close + 1;
+        }
+    } else if (isOperatorChar(*pos)) {
+        lexer->text[length++] = *pos++;
+        if (*pos == '=' && lexer->text[0] != '=' && lexer->text[0] != '~') {
+            lexer->text[length++] = *pos++;
+        }
+        if (length == 1 && lexer->text[0] == '^') {
+            printf("Error: Use ^= for a prefix match.\n");
+        } else {
+            lexer->type = TOKEN_OPERATOR;
+        }
+    } else {
+        while (*pos != '\0' && !isspace((unsigned char)*pos) && !isOperatorChar(*pos)) {
+            if (length == QUERY_MAX_TEXT - 1) {
+                printf("Error: Query value is too long.\n");
+                lexer->pos = pos;
+                return TOKEN_ERROR;
+            }
+            lexer->text[length++] = *pos++;
+        }
+        lexer->type = TOKEN_WORD;
+    }
+    lexer->text[length] = '\0';
+    lexer->pos = pos;
+    return lexer->type;
+}
+
+// Is the current token the bare keyword word (any case)?
+static int isKeyword(const QueryLexer *lexer, const char *word) {
+    return lexer->type == TOKEN_WORD && !lexer->quoted && strcasecmp(lexer->text, word) == 0;
+}
+
+// Store a value as a term operand: roll numbers are parsed, phones reduced
+// to their digits so they compare like the phone index
+static int storeOperand(QueryTerm *term, const char *value, char *text, long *number) {
+    if (term->field == QUERY_ROLL) {
+        char *end;
+        *number = strtol(value, &end, 10);
+        if (*value == '\0' || *end != '\0' || *number < 0 || *number > INT_MAX) {
+            printf("Error: Invalid roll number '%s' in query.\n", value);
+            return 0;
+        }
+        return 1;
+    }
+    if (term->field == QUERY_PHONE) {
+        char digits[QUERY_MAX_TEXT];
+        size_t length = 0;
+        for (const char *c = value; *c != '\0'; c++) {
+            if (isdigit((unsigned char)*c)) {
+                digits[length++] = *c;
+            }
+        }
+        digits[length] = '\0';
+        strcpy(text, digits);
+        return 1;
+    }
+    strcpy(text, value);
+    return 1;
+}
+
+// Read the next token as an operand of term; what names it in errors
+static int readOperand(QueryLexer *lexer, QueryTerm *term, char *text, long *number, const char *what) {
+    if (nextToken(lexer) != TOKEN_WORD) {
+        if (lexer->type != TOKEN_ERROR) {
+            printf("Error: Missing %s in query.\n", what);
+        }
+        return 0;
+    }
+    return storeOperand(term, lexer->text, text, number);
+}
+
+// Parse "<op> <value>" or "between <low> and <high>" after a field name
+static int parseCondition(QueryLexer *lexer, QueryTerm *term) {
+    if (isKeyword(lexer, "between")) {
+        term->match = MATCH_RANGE;
+        term->has_low = term->has_high = 1;
+        if (!readOperand(lexer, term, term->text, &term->low, "low value after 'between'")) {
+            return 0;
+        }
+        if (nextToken(lexer) != TOKEN_WORD || !isKeyword(lexer, "and")) {
+            printf("Error: Expected 'and' after the low value of 'between'.\n");
+            return 0;
+        }
+        return readOperand(lexer, term, term->high_text, &term->high, "high value after 'between'");
+    }
+    if (lexer->type != TOKEN_OPERATOR) {
+        if (lexer->type != TOKEN_ERROR) {
+            printf("Error: Expected =, ^=, ~, <, <=, >, >= or between after '%s'.\n",
+                   field_names[term->field]);
+        }
+        return 0;
+    }
+
+    char op[3];
+    strcpy(op, lexer->text);
+    if (strcmp(op, "=") == 0) {
+        term->match = MATCH_EQUAL;
+        term->has_low = term->has_high = 1;
+        if (!readOperand(lexer, term, term->text, &term->low, "value after '='")) {
+            return 0;
+        }
+        term->high = term->low;
+        return 1;
+    }
+    if (strcmp(op, "^=") == 0 || strcmp(op, "~") == 0) {
+        if (term->field == QUERY_ROLL) {
+            printf("Error: Roll numbers support =, <, <=, >, >= and between.\n");
+            return 0;
+        }
+        term->match = op[0] == '~' ? MATCH_CONTAINS : MATCH_PREFIX;
+        return readOperand(lexer, term, term->text, &term->low, "value after the operator");
+    }
+    if (op[0] != '<' && op[0] != '>') {
+        printf("Error: Unknown operator '%s' in query.\n", op);
+        return 0;
+    }
+
+    // One-sided range. Roll bounds are made inclusive; text bounds keep a flag.
+    int exclusive = op[1] == '\0';
+    int is_roll = term->field == QUERY_ROLL;
+    term->match = MATCH_RANGE;
+    if (op[0] == '>') {
+        term->has_low = 1;
+        if (!readOperand(lexer, term, term->text, &term->low, "value after the operator")) {
+            return 0;
+        }
+        term->low += is_roll && exclusive;
+        term->low_exclusive = !is_roll && exclusive;
+    } else {
+        term->has_high = 1;
+        if (!readOperand(lexer, term, term->high_text, &term->high, "value after the operator")) {
+            return 0;
+        }
+        term->high -= is_roll && exclusive;
+        term->high_exclusive = !is_roll && exclusive;
+    }
+    return 1;
+}
+
+// Parse query text into query; prints the problem and returns 0 if invalid
+int parseQuery(const char *text, Query *query) {
+    QueryLexer lexer;
+    lexer.pos = text;
+    memset(query, 0, sizeof(*query));
+
+    nextToken(&lexer);
+    while (1) {
+        if (lexer.type == TOKEN_ERROR) {
+            return 0;
+        }
+        if (lexer.type != TOKEN_WORD || lexer.quoted) {
+            printf(lexer.type == TOKEN_END ? "Error: Query is empty or ends early.\n"
+                                           : "Error: Expected a field name in query.\n");
+            return 0;
+        }
+        if (query->term_count == QUERY_MAX_TERMS) {
+            printf("Error: A query can have at most %d conditions.\n", QUERY_MAX_TERMS);
+            return 0;
+        }
+
+        QueryTerm *term = &query->terms[query->term_count];
+        int field = -1;
+        for (int f = 0; f < (int)(sizeof(field_names) / sizeof(field_names[0])); f++) {
+            if (strcasecmp(lexer.text, field_names[f]) == 0) {
+                field = f;
+            }
+        }
+        if (strcasecmp(lexer.text, "department") == 0) {
+            field = QUERY_DEPARTMENT;
+        }
+        if (field == -1) {
+            printf("Error: Unknown field '%s' (use name, phone, email, roll or dept).\n", lexer.text);
+            return 0;
+        }
+        term->field = (QueryField)field;
+        nextToken(&lexer);
+        if (!parseCondition(&lexer, term)) {
+            return 0;
+        }
+        query->term_count++;
+
+        nextToken(&lexer);
+        if (lexer.type == TOKEN_END || isKeyword(&lexer, "or")) {
+            if (query->clause_count == QUERY_MAX_CLAUSES) {
+                printf("Error: A query can have at most %d 'or' clauses.\n", QUERY_MAX_CLAUSES);
+                return 0;
+            }
+            query->clause_end[query->clause_count++] = query->term_count;
+            if (lexer.type == TOKEN_END) {
+                return 1;
+            }
+        } else if (!isKeyword(&lexer, "and")) {
+            if (lexer.type != TOKEN_ERROR) {
+                printf("Error: Expected 'and' or 'or' before '%s' (quote values with spaces).\n",
+                       lexer.text);
+            }
+            return 0;
+        }
+        nextToken(&lexer);
+    }
+}
+
+// Does haystack contain needle, ignoring case?
+static int containsIgnoringCase(const char *haystack, const char *needle) {
+    size_t length = strlen(needle);
+    for (; *haystack != '\0'; haystack++) {
+        if (strncasecmp(haystack, needle, length) == 0) {
+            return 1;
+        }
+    }
+    return length == 0;
+}
+
+// Text of field for the contact in slot (phones as digits, in buffer)
+static const char *fieldText(const AddressBook *book, QueryField field, int slot, char *buffer) {
+    switch (field) {
+        case QUERY_NAME:
+            return contactName(book, slot);
+        case QUERY_PHONE:
+            normalizePhone(contactPhone(book, slot), buffer);
+            return buffer;
+        case QUERY_EMAIL:
+            return contactEmail(book, slot);
+        default:
+            return contactDepartment(book, slot);
+    }
+}
+
+// Does the contact in slot satisfy term?
+static int termMatches(const AddressBook *book, const QueryTerm *term, int slot) {
+    if (term->field == QUERY_ROLL) {
+        long roll_no = book->contacts[slot].roll_no;
+        return (!term->has_low || roll_no >= term->low) && (!term->has_high || roll_no <= term->high);
+    }
+
+    char digits[MAX_PHONE_LEN];
+    const char *value = fieldText(book, term->field, slot, digits);
+    switch (term->match) {
+        case MATCH_EQUAL:
+            return strcasecmp(value, term->text) == 0;
+        case MATCH_PREFIX:
+            return strncasecmp(value, term->text, strlen(term->text)) == 0;
+        case MATCH_CONTAINS:
+            return containsIgnoringCase(value, term->text);
+        default:
+            if (term->has_low) {
+                int cmp = strcasecmp(value, term->text);
+                if (cmp < 0 || (cmp == 0 && term->low_exclusive)) {
+                    return 0;
+                }
+            }
+            if (term->has_high) {
+                int cmp = strcasecmp(value, term->high_text);
+                if (cmp > 0 || (cmp == 0 && term->high_exclusive)) {
+                    return 0;
+                }
+            }
+            return 1;
+    }
+}
+
+// Does the contact in slot satisfy every term of clause?
+static int clauseMatches(const AddressBook *book, const Query *query, int clause, int slot) {
+    int first = clause > 0 ? query->clause_end[clause - 1] : 0;
+    for (int t = first; t < query->clause_end[clause]; t++) {
+        if (!termMatches(book, &query->terms[t], slot)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Compare the text field of the contact in slot with a key: its first
+// prefix_length characters, or all of it when prefix_length is 0
+static int compareToKey(const AddressBook *book, QueryField field, int slot,
+                        const char *key, size_t prefix_length) {
+    char digits[MAX_PHONE_LEN];
+    const char *value = fieldText(book, field, slot, digits);
+    return prefix_length > 0 ? strncasecmp(value, key, prefix_length) : strcasecmp(value, key);
+}
+
+// First position in order whose field compares > key (after) or >= key
+static int orderBound(const AddressBook *book, const int *order, QueryField field,
+                      const char *key, size_t prefix_length, int after) {
+    int left = 0, right = book->order_count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        int cmp = compareToKey(book, field, order[mid], key, prefix_length);
+        if (cmp < 0 || (after && cmp == 0)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Plan the range of the name or phone order that holds a term's matches
+static void planOrderRange(const AddressBook *book, const QueryTerm *term, QueryPlan *plan) {
+    size_t prefix_length = term->match == MATCH_PREFIX ? strlen(term->text) : 0;
+    if (term->match == MATCH_RANGE) {
+        plan->first = term->has_low
+            ? orderBound(book, plan->slots, term->field, term->text, 0, term->low_exclusive)
+            : 0;
+        plan->last = term->has_high
+            ? orderBound(book, plan->slots, term->field, term->high_text, 0, !term->high_exclusive)
+            : book->order_count;
+    } else {
+        plan->first = orderBound(book, plan->slots, term->field, term->text, prefix_length, 0);
+        plan->last = orderBound(book, plan->slots, term->field, term->text, prefix_length, 1);
+    }
+    if (plan->last < plan->first) {
+        plan->last = plan->first;
+    }
+    plan->estimate = plan->last - plan->first + (book->count - book->sorted_count);
+}
+
+// Plan the range of roll_order holding a roll term's matches, located
+// through the fence pointers over its roll numbers
+static void planRollRange(const AddressBook *book, const QueryTerm *term, QueryPlan *plan) {
+    const FenceIndex *fences = &book->roll_fences;
+    plan->first = 0;
+    plan->last = fences->count;
+    if (term->has_low && term->low > INT_MAX) {
+        plan->first = fences->count;
+    } else if (term->has_low) {
+        plan->first = fenceLowerBound(fences, (int)term->low);
+    }
+    if (term->has_high && term->high < 0) {
+        plan->last = 0;
+    } else if (term->has_high) {
+        plan->last = fenceUpperBound(fences, (int)term->high);
+    }
+    if (plan->last < plan->first) {
+        plan->last = plan->first;
+    }
+    plan->estimate = plan->last - plan->first + (book->count - book->sorted_count);
+}
+
+// An empty prefix (e.g. a phone prefix with no digits) matches every
+// contact, so no order range narrows it
+static int isEmptyPrefix(const QueryTerm *term) {
+    return term->match == MATCH_PREFIX && term->text[0] == '\0';
+}
+
+// The cheapest source an index offers for term; returns 0 if none applies
+static int planTerm(const AddressBook *book, const QueryTerm *term, QueryPlan *plan) {
+    plan->slots = NULL;
+    switch (term->field) {
+        case QUERY_ROLL:
+            if (term->has_low && term->has_high && term->low == term->high) {
+                int slot = findContactByRoll(book, (int)term->low);
+                plan->source = SOURCE_ROLL_INDEX;
+                plan->first = slot != -1 ? slot : 0;
+                plan->last = slot != -1 ? slot + 1 : 0;
+                plan->estimate = slot != -1;
+                return 1;
+            }
+            plan->source = SOURCE_ROLL_ORDER;
+            plan->slots = book->roll_order;
+            planRollRange(book, term, plan);
+            return 1;
+        case QUERY_DEPARTMENT:
+            if (term->match != MATCH_EQUAL) {
+                return 0;
+            }
+            plan->source = SOURCE_DEPARTMENT;
+            plan->first = 0;
+            plan->last = findContactsByDepartment(book, term->text, &plan->slots);
+            plan->estimate = plan->last;
+            return 1;
+        case QUERY_NAME:
+            if (term->match == MATCH_CONTAINS || isEmptyPrefix(term)) {
+                return 0;
+            }
+            plan->source = SOURCE_NAME_ORDER;
+            plan->slots = book->name_order;
+            break;
+        case QUERY_PHONE:
+            if (term->match == MATCH_CONTAINS || isEmptyPrefix(term)) {
+                return 0;
+            }
+            plan->source = SOURCE_PHONE_ORDER;
+            plan->slots = book->phone_order;
+            break;
+        default:
+            return 0;
+    }
+    planOrderRange(book, term, plan);
+    return 1;
+}
+
+// Start streaming the matches of query: each clause gets the most selective
+// index among its terms, or a scan when none has one
+void startQuery(QueryIterator *iterator, const AddressBook *book, const Query *query) {
+    iterator->book = book;
+    iterator->query = query;
+    iterator->clause = 0;
+    iterator->position = -1;
+    iterator->pending = -1;
+
+    for (int c = 0; c < query->clause_count; c++) {
+        QueryPlan *best = &iterator->plans[c];
+        best->source = SOURCE_SCAN;
+        best->term = -1;
+        best->slots = NULL;
+        best->first = 0;
+        best->last = book->count;
+        best->estimate = book->count;
+
+        int first = c > 0 ? query->clause_end[c - 1] : 0;
+        for (int t = first; t < query->clause_end[c]; t++) {
+            QueryPlan candidate;
+            if (planTerm(book, &query->terms[t], &candidate) && candidate.estimate < best->estimate) {
+                candidate.term = t;
+                *best = candidate;
+            }
+        }
+    }
+}
+
+// Next candidate slot of the current clause's source, or -1 once it is spent
+static int nextCandidate(QueryIterator *iterator) {
+    const AddressBook *book = iterator->book;
+    QueryPlan *plan = &iterator->plans[iterator->clause];
+    if (iterator->position == -1) {
+        iterator->position = plan->first;
+    }
+    if (iterator->position < plan->last) {
+        int position = iterator->position++;
+        return plan->slots != NULL ? plan->slots[position] : position;
+    }
+
+    // Order ranges miss the contacts appended since the orders were refreshed
+    if (plan->source == SOURCE_NAME_ORDER || plan->source == SOURCE_ROLL_ORDER ||
+        plan->source == SOURCE_PHONE_ORDER) {
+        if (iterator->pending == -1) {
+            iterator->pending = book->sorted_count;
+        }
+        if (iterator->pending < book->count) {
+            return iterator->pending++;
+        }
+    }
+    return -1;
+}
+
+// The next matching slot, or -1 when there are no more. A contact matching
+// several clauses is produced once, by the first of them.
+int nextQueryResult(QueryIterator *iterator) {
+    const AddressBook *book = iterator->book;
+    const Query *query = iterator->query;
+    while (iterator->clause < query->clause_count) {
+        int slot = nextCandidate(iterator);
+        if (slot == -1) {
+            iterator->clause++;
+            iterator->position = -1;
+            iterator->pending = -1;
+            continue;
+        }
+        if (!isLiveSlot(book, slot) || !clauseMatches(book, query, iterator->clause, slot)) {
+            continue;
+        }
+        int seen = 0;
+        for (int c = 0; c < iterator->clause && !seen; c++) {
+            seen = clauseMatches(book, query, c, slot);
+        }
+        if (!seen) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+// Print the plan: the source chosen for each clause and its estimated size
+void describeQueryPlan(const QueryIterator *iterator, FILE *out) {
+    static const char *source_names[] = {
+        "full scan", "roll number index", "department index", "name index",
+        "roll order", "phone index"
+    };
+    for (int c = 0; c < iterator->query->clause_count; c++) {
+        const QueryPlan *plan = &iterator->plans[c];
+        fprintf(out, "Plan: clause %d via %s", c + 1, source_names[plan->source]);
+        if (plan->term != -1) {
+            fprintf(out, " on %s", field_names[iterator->query->terms[plan->term].field]);
+        }
+        fprintf(out, " (%d candidate(s))\n", plan->estimate);
+    }
+}
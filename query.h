@@ -0,0 +1,88 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <stdio.h>
+#include "contact.h"
+
+#define QUERY_MAX_TERMS 16          // Predicates in one query
+#define QUERY_MAX_CLAUSES 8         // "or"-separated clauses in one query
+#define QUERY_MAX_TEXT 100          // Longest operand (the longest field is an email)
+
+// Fields a predicate can test
+typedef enum {
+    QUERY_NAME,
+    QUERY_PHONE,                // Compared on digits only, like the phone index
+    QUERY_EMAIL,
+    QUERY_ROLL,
+    QUERY_DEPARTMENT
+} QueryField;
+
+// Kinds of predicate (text comparisons ignore case)
+typedef enum {
+    MATCH_EQUAL,                // field = value
+    MATCH_PREFIX,               // field ^= value
+    MATCH_CONTAINS,             // field ~ value
+    MATCH_RANGE                 // field between low and high, or <, <=, >, >=
+} QueryMatch;
+
+// One predicate. Ranges may be open at either end; roll bounds are always
+// stored inclusive.
+typedef struct {
+    QueryField field;
+    QueryMatch match;
+    char text[QUERY_MAX_TEXT];  // Operand, or the low bound of a text range
+    char high_text[QUERY_MAX_TEXT];
+    long low;                   // Roll bounds
+    long high;
+    int has_low;
+    int has_high;
+    int low_exclusive;          // Text ranges only
+    int high_exclusive;
+} QueryTerm;
+
+// A disjunction of conjunctions: clause c holds terms [clause_end[c - 1], clause_end[c])
+typedef struct {
+    QueryTerm terms[QUERY_MAX_TERMS];
+    int term_count;
+    int clause_end[QUERY_MAX_CLAUSES];
+    int clause_count;
+} Query;
+
+// Where a clause's candidates come from. A range of a sorted order is
+// followed by the slots appended since the orders were last refreshed.
+typedef enum {
+    SOURCE_SCAN,                // Every slot
+    SOURCE_ROLL_INDEX,          // The roll number hash (at most one slot)
+    SOURCE_DEPARTMENT,          // A department's member list
+    SOURCE_NAME_ORDER,          // A range of name_order
+    SOURCE_ROLL_ORDER,          // A range of roll_order
+    SOURCE_PHONE_ORDER          // A range of phone_order
+} QuerySource;
+
+// The planner's choice for one clause
+typedef struct {
+    QuerySource source;
+    int term;                   // Term the source answers (-1 for a scan)
+    const int *slots;           // Slots walked: member list or sorted order
+    int first;                  // Range of slots[] (or of slot numbers for a scan)
+    int last;
+    int estimate;               // Candidates the source yields
+} QueryPlan;
+
+// Streams the matches of a query; valid until the book changes
+typedef struct {
+    const AddressBook *book;
+    const Query *query;
+    QueryPlan plans[QUERY_MAX_CLAUSES];
+    int clause;                 // Clause being produced
+    int position;               // Next position in its source
+    int pending;                // Next unindexed slot once an order range is done (-1 before)
+} QueryIterator;
+
+// Function declarations for the query engine
+int parseQuery(const char *text, Query *query);
+void startQuery(QueryIterator *iterator, const AddressBook *book, const Query *query);
+int nextQueryResult(QueryIterator *iterator);
+void describeQueryPlan(const QueryIterator *iterator, FILE *out);
+
+#endif // QUERY_H
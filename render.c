@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "render.h"
+
+// Set up a renderer writing to out
+int initializeRenderer(Renderer *renderer, FILE *out) {
+    renderer->out = out;
+    renderer->used = 0;
+    renderer->data = malloc(RENDER_BUFFER_SIZE);
+    if (renderer->data == NULL) {
+        printf("Memory allocation failed!\n");
+        renderer->capacity = 0;
+        return 0;
+    }
+    renderer->capacity = RENDER_BUFFER_SIZE;
+    return 1;
+}
+
+// Write out anything pending and release the buffer
+void freeRenderer(Renderer *renderer) {
+    flushRenderer(renderer);
+    free(renderer->data);
+    renderer->data = NULL;
+    renderer->capacity = 0;
+}
+
+// Hand the buffered output to the stream in one write. Anything the stream
+// already holds (headers printed with printf) goes out first.
+int flushRenderer(Renderer *renderer) {
+    if (renderer->used == 0) {
+        return 1;
+    }
+    int ok = fflush(renderer->out) == 0 &&
+             fwrite(renderer->data, 1, renderer->used, renderer->out) == renderer->used &&
+             fflush(renderer->out) == 0;
+    renderer->used = 0;
+    return ok;
+}
+
+// Append length bytes of text
+void renderText(Renderer *renderer, const char *text, size_t length) {
+    if (renderer->used + length > renderer->capacity) {
+        flushRenderer(renderer);
+        if (length > renderer->capacity) {
+            fwrite(text, 1, length, renderer->out);
+            return;
+        }
+    }
+    memcpy(renderer->data + renderer->used, text, length);
+    renderer->used += length;
+}
+
+// Append one character
+void renderChar(Renderer *renderer, char c) {
+    if (renderer->used == renderer->capacity) {
+        flushRenderer(renderer);
+    }
+    renderer->data[renderer->used++] = c;
+}
+
+// Append text left-justified in a field of width characters (like "%-*s":
+// longer text is kept whole)
+void renderPadded(Renderer *renderer, const char *text, int width) {
+    size_t length = strlen(text);
+    renderText(renderer, text, length);
+    for (int pad = width - (int)length; pad > 0; pad--) {
+        renderChar(renderer, ' ');
+    }
+}
+
+// Append a decimal integer left-justified in width characters (like "%-*d")
+void renderNumber(Renderer *renderer, int value, int width) {
+    char digits[16];
+    int length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[sizeof(digits) - 1 - length++] = '-';
+    }
+    renderText(renderer, digits + sizeof(digits) - length, length);
+    for (int pad = width - length; pad > 0; pad--) {
+        renderChar(renderer, ' ');
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define RENDER_BUFFER_SIZE (1 << 20)    // Output gathered before each write
+
+// Collects formatted output and hands it to the stream in large blocks,
+// instead of one printf per row
+typedef struct {
+    FILE *out;
+    char *data;
+    size_t used;
+    size_t capacity;
+} Renderer;
+
+// Function declarations for the buffered renderer
+int initializeRenderer(Renderer *renderer, FILE *out);
+void freeRenderer(Renderer *renderer);
+int flushRenderer(Renderer *renderer);
+void renderText(Renderer *renderer, const char *text, size_t length);
+void renderChar(Renderer *renderer, char c);
+void renderPadded(Renderer *renderer, const char *text, int width);
+void renderNumber(Renderer *renderer, int value, int width);
+
+#endif // RENDER_H
@@ -0,0 +1,436 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "server.h"
+#include "command.h"
+#include "file.h"
+#include "validate.h"
+
+#ifdef _WIN32
+
+// Unix domain sockets and POSIX threads are not available here
+int runServer(AddressBook *book, const char *socket_path) {
+    (void)book;
+    (void)socket_path;
+    printf("Error: Server mode is only available on Unix-like systems.\n");
+    return 0;
+}
+
+#else
+
+// Accepted connections waiting for a worker (a ring buffer), plus the
+// connection each worker is serving so shutdown can interrupt it
+typedef struct {
+    int fds[SERVER_QUEUE_SIZE];
+    int head;
+    int count;
+    int active[SERVER_THREADS]; // -1 when the worker is idle
+    int stopping;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+} ConnectionQueue;
+
+// Shared state: lookups hold the lock for reading and run in parallel,
+// changes hold it for writing and run one at a time
+typedef struct {
+    AddressBook *book;
+    pthread_rwlock_t lock;
+    ConnectionQueue queue;
+} Server;
+
+// Argument of a worker thread
+typedef struct {
+    Server *server;
+    int index;
+} Worker;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+// SIGINT/SIGTERM handler: let the accept loop wind down
+static void requestStop(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+// Hand a connection to the workers; returns 0 if the queue is full
+static int queuePush(ConnectionQueue *queue, int fd) {
+    pthread_mutex_lock(&queue->mutex);
+    int queued = queue->count < SERVER_QUEUE_SIZE;
+    if (queued) {
+        queue->fds[(queue->head + queue->count) % SERVER_QUEUE_SIZE] = fd;
+        queue->count++;
+        pthread_cond_signal(&queue->not_empty);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return queued;
+}
+
+// Next connection for worker to serve; -1 once the server is stopping
+static int queuePop(ConnectionQueue *queue, int worker) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count == 0 && !queue->stopping) {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);
+    }
+    int fd = -1;
+    if (!queue->stopping) {
+        fd = queue->fds[queue->head];
+        queue->head = (queue->head + 1) % SERVER_QUEUE_SIZE;
+        queue->count--;
+        queue->active[worker] = fd;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return fd;
+}
+
+// Worker has finished with its connection
+static void queueDone(ConnectionQueue *queue, int worker) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->active[worker] = -1;
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Stop handing out connections and cut the ones being served, so workers
+// blocked reading from idle clients return
+static void queueStop(ConnectionQueue *queue) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->stopping = 1;
+    for (int i = 0; i < SERVER_THREADS; i++) {
+        if (queue->active[i] != -1) {
+            shutdown(queue->active[i], SHUT_RDWR);
+        }
+    }
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Protocol: one request per line, answered by "OK <n>" and n CSV lines
+// (n = 0 when there is nothing to list) or by a single "ERR <reason>" line.
+//   FIND ROLL <roll_no> | FIND DEPT <department> | FIND NAME <name> | FIND PHONE <phone>
+//   ADD <name>,<phone>,<email>,<roll_no>,<department>   (replies with the contact)
+//   DELETE <roll_no>                                    (replies with the contact)
+//   PING | QUIT
+// Every change is saved before it is acknowledged.
+
+// Reply with "OK <n>" followed by n contacts as CSV lines
+static void replyContacts(FILE *out, const Contact *contacts, int count) {
+    fprintf(out, "OK %d\n", count);
+    for (int i = 0; i < count; i++) {
+        writeContactCSV(&contacts[i], out);
+    }
+}
+
+// FIND <ROLL|DEPT|NAME|PHONE> <value>. Matches are copied out under the
+// read lock so a slow client never holds up writers.
+static void handleFind(Server *server, char *args, FILE *out) {
+    char *value = strchr(args, ' ');
+    if (value == NULL) {
+        fprintf(out, "ERR usage: FIND <ROLL|DEPT|NAME|PHONE> <value>\n");
+        return;
+    }
+    *value++ = '\0';
+    
+    pthread_rwlock_rdlock(&server->lock);
+    int *slots;
+    int count = findMatches(server->book, args, value, &slots);
+    Contact *matches = NULL;
+    if (count > 0) {
+        matches = malloc(count * sizeof(Contact));
+        if (matches == NULL) {
+            count = FIND_FAILED;
+        } else {
+            for (int i = 0; i < count; i++) {
+                getContact(server->book, slots[i], &matches[i]);
+            }
+        }
+    }
+    pthread_rwlock_unlock(&server->lock);
+    free(slots);
+    
+    switch (count) {
+        case FIND_BAD_FIELD:
+            fprintf(out, "ERR unknown field %s\n", args);
+            break;
+        case FIND_BAD_VALUE:
+            fprintf(out, "ERR invalid value %s\n", value);
+            break;
+        case FIND_FAILED:
+            fprintf(out, "ERR out of memory\n");
+            break;
+        default:
+            replyContacts(out, matches, count);
+            break;
+    }
+    free(matches);
+}
+
+// ADD <name>,<phone>,<email>,<roll_no>,<department> (one CSV record)
+static void handleAdd(Server *server, const char *args, FILE *out) {
+    Contact contact;
+    unsigned long long valid;
+    if (!parseContactCSV(args, &contact)) {
+        fprintf(out, "ERR usage: ADD <name>,<phone>,<email>,<roll_no>,<department>\n");
+        return;
+    }
+    validateContactBatch(&contact, 1, &valid);
+    if (!(valid & 1) || contact.roll_no <= 0) {
+        fprintf(out, "ERR invalid contact\n");
+        return;
+    }
+    
+    pthread_rwlock_wrlock(&server->lock);
+    AddressBook *book = server->book;
+    const char *error = NULL;
+    if (findContactByRoll(book, contact.roll_no) != -1) {
+        error = "roll number exists";
+    } else if (book->reject_duplicate_phones && findContactByPhone(book, contact.phone) != -1) {
+        error = "phone number exists";
+    } else if (!appendContact(book, &contact) || !refreshSortedIndexes(book) ||
+               !saveAddressBook(book, CSV_FILENAME)) {
+        error = "could not save";
+    }
+    pthread_rwlock_unlock(&server->lock);
+    
+    if (error != NULL) {
+        fprintf(out, "ERR %s\n", error);
+    } else {
+        replyContacts(out, &contact, 1);
+    }
+}
+
+// DELETE <roll_no>
+static void handleDelete(Server *server, const char *args, FILE *out) {
+    char *end;
+    long roll_no = strtol(args, &end, 10);
+    if (*args == '\0' || *end != '\0' || roll_no <= 0 || roll_no > 2147483647L) {
+        fprintf(out, "ERR usage: DELETE <roll_no>\n");
+        return;
+    }
+    
+    pthread_rwlock_wrlock(&server->lock);
+    AddressBook *book = server->book;
+    const char *error = NULL;
+    Contact removed;
+    int slot = findContactByRoll(book, (int)roll_no);
+    if (slot == -1) {
+        error = "not found";
+    } else {
+        getContact(book, slot, &removed);
+        if (!removeContact(book, slot) || !saveAddressBook(book, CSV_FILENAME)) {
+            error = "could not save";
+        }
+    }
+    pthread_rwlock_unlock(&server->lock);
+    
+    if (error != NULL) {
+        fprintf(out, "ERR %s\n", error);
+    } else {
+        replyContacts(out, &removed, 1);
+    }
+}
+
+// Answer requests from one client until it disconnects or sends QUIT
+static void serveConnection(Server *server, int worker, int fd) {
+    int read_fd = dup(fd);
+    FILE *in = read_fd == -1 ? NULL : fdopen(read_fd, "r");
+    FILE *out = fdopen(fd, "w");
+    if (in == NULL || out == NULL) {
+        if (in != NULL) {
+            fclose(in);
+        } else if (read_fd != -1) {
+            close(read_fd);
+        }
+        queueDone(&server->queue, worker);
+        if (out != NULL) {
+            fclose(out);
+        } else {
+            close(fd);
+        }
+        return;
+    }
+    
+    char line[SERVER_LINE_MAX];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        size_t len = strcspn(line, "\r\n");
+        if (line[len] == '\0' && !feof(in)) {
+            // Overlong request: discard the rest of the line
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n') {
+            }
+            fprintf(out, "ERR request too long\n");
+            fflush(out);
+            continue;
+        }
+        line[len] = '\0';
+        
+        char *args = strchr(line, ' ');
+        if (args != NULL) {
+            *args++ = '\0';
+        } else {
+            args = line + len;
+        }
+        if (strcasecmp(line, "FIND") == 0) {
+            handleFind(server, args, out);
+        } else if (strcasecmp(line, "ADD") == 0) {
+            handleAdd(server, args, out);
+        } else if (strcasecmp(line, "DELETE") == 0) {
+            handleDelete(server, args, out);
+        } else if (strcasecmp(line, "PING") == 0) {
+            fprintf(out, "OK 0\n");
+        } else if (strcasecmp(line, "QUIT") == 0) {
+            fprintf(out, "OK 0\n");
+            break;
+        } else if (line[0] != '\0') {
+            fprintf(out, "ERR unknown request %s\n", line);
+        }
+        if (fflush(out) != 0) {
+            break; // Client went away
+        }
+    }
+    queueDone(&server->queue, worker);
+    fclose(in);
+    fclose(out);
+}
+
+// Worker thread: serve queued connections until shutdown
+static void *serverWorker(void *arg) {
+    Worker *worker = arg;
+    int fd;
+    while ((fd = queuePop(&worker->server->queue, worker->index)) != -1) {
+        serveConnection(worker->server, worker->index, fd);
+    }
+    return NULL;
+}
+
+// Bind and listen on socket_path, replacing a stale socket file but never
+// one a running server still answers on. Returns the socket or -1.
+static int openListener(const char *socket_path) {
+    struct sockaddr_un address;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        printf("Error: Socket path %s is too long.\n", socket_path);
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        printf("Error: Unable to create socket.\n");
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) == 0) {
+        printf("Error: A server is already listening on %s.\n", socket_path);
+        close(fd);
+        return -1;
+    }
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(fd, SERVER_QUEUE_SIZE) != 0) {
+        printf("Error: Unable to listen on %s.\n", socket_path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Serve the already loaded book on a Unix domain socket until SIGINT or
+// SIGTERM. Returns 1 after a clean shutdown, 0 if the server could not start.
+int runServer(AddressBook *book, const char *socket_path) {
+    int listener = openListener(socket_path);
+    if (listener == -1) {
+        return 0;
+    }
+    
+    Server server;
+    server.book = book;
+    pthread_rwlock_init(&server.lock, NULL);
+    memset(&server.queue, 0, sizeof(server.queue));
+    for (int i = 0; i < SERVER_THREADS; i++) {
+        server.queue.active[i] = -1;
+    }
+    pthread_mutex_init(&server.queue.mutex, NULL);
+    pthread_cond_init(&server.queue.not_empty, NULL);
+    
+    // No SA_RESTART: a signal must interrupt accept()
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = requestStop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    action.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &action, NULL); // A vanished client is a write error, not a crash
+    
+    // Workers block the stop signals so they always reach the accept loop
+    sigset_t stop_signals, previous;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, &previous);
+    pthread_t threads[SERVER_THREADS];
+    Worker workers[SERVER_THREADS];
+    int started = 0;
+    while (started < SERVER_THREADS) {
+        workers[started].server = &server;
+        workers[started].index = started;
+        if (pthread_create(&threads[started], NULL, serverWorker, &workers[started]) != 0) {
+            break;
+        }
+        started++;
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    
+    if (started == 0) {
+        printf("Error: Unable to start worker threads.\n");
+    } else {
+        printf("Serving %d contact(s) on %s with %d worker(s). Press Ctrl+C to stop.\n",
+               countContacts(book), socket_path, started);
+        fflush(stdout);
+        while (!stop_requested) {
+            int client = accept(listener, NULL, NULL);
+            if (client == -1) {
+                if (errno != EINTR && errno != ECONNABORTED) {
+                    printf("Error: accept failed, stopping server.\n");
+                    break;
+                }
+                continue;
+            }
+            if (!queuePush(&server.queue, client)) {
+                static const char busy[] = "ERR server busy\n";
+                if (write(client, busy, sizeof(busy) - 1) < 0) {
+                    // The client is turned away either way
+                }
+                close(client);
+            }
+        }
+    }
+    
+    // Requests in progress finish; idle and queued connections are closed
+    queueStop(&server.queue);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < server.queue.count; i++) {
+        close(server.queue.fds[(server.queue.head + i) % SERVER_QUEUE_SIZE]);
+    }
+    close(listener);
+    unlink(socket_path);
+    pthread_cond_destroy(&server.queue.not_empty);
+    pthread_mutex_destroy(&server.queue.mutex);
+    pthread_rwlock_destroy(&server.lock);
+    printf("Server stopped.\n");
+    return started > 0;
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "contact.h"
+
+#define SERVER_SOCKET_PATH "addressbook.sock"
+#define SERVER_THREADS 8        // Worker threads, one client connection each
+#define SERVER_QUEUE_SIZE 64    // Accepted connections waiting for a worker
+#define SERVER_LINE_MAX 512     // Longest request line
+
+// Function declarations for the query server
+int runServer(AddressBook *book, const char *socket_path);
+
+#endif // SERVER_H
@@ -0,0 +1,153 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#include "stats.h"
+
+// Per-operation latency histogram
+typedef struct {
+    unsigned long long count;
+    unsigned long long total_ns;
+    unsigned long long max_ns;
+    unsigned long long buckets[STAT_BUCKETS];
+} StatHistogram;
+
+static const char *timer_names[STAT_TIMER_COUNT] = {
+    "Load CSV", "Save CSV", "Backup", "Snapshot load", "Snapshot save",
+    "Roll lookup", "Phone lookup", "Department lookup",
+    "Linear name search", "Linear phone search", "Linear roll search", "Department listing",
+    "Binary name search", "Binary roll search", "Name prefix", "Phone prefix",
+    "Roll range", "Fuzzy name search", "Sounds-like search", "Sort", "Delete", "Compaction"
+};
+
+static const char *counter_names[STAT_COUNTER_COUNT] = {
+    "Reallocations", "Bytes reallocated", "Bytes read", "Bytes written"
+};
+
+int stats_enabled = 0;
+static StatHistogram histograms[STAT_TIMER_COUNT];
+static unsigned long long counters[STAT_COUNTER_COUNT];
+
+// Server workers search concurrently, so updates are serialized
+#ifndef _WIN32
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+#define lockStats() pthread_mutex_lock(&stats_lock)
+#define unlockStats() pthread_mutex_unlock(&stats_lock)
+#else
+#define lockStats() ((void)0)
+#define unlockStats() ((void)0)
+#endif
+
+// Start collecting
+void enableStats(void) {
+    stats_enabled = 1;
+}
+
+// Forget everything collected so far
+void resetStats(void) {
+    lockStats();
+    memset(histograms, 0, sizeof(histograms));
+    memset(counters, 0, sizeof(counters));
+    unlockStats();
+}
+
+// Monotonic clock in nanoseconds
+unsigned long long statsClock(void) {
+#ifdef _WIN32
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)(now.QuadPart * (1000000000.0 / frequency.QuadPart));
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+// Record one call of timer that began at start
+void statsRecord(StatTimer timer, unsigned long long start) {
+    if (start == 0) {
+        return; // Collection was turned on after the operation began
+    }
+    unsigned long long elapsed = statsClock() - start;
+    int bucket = 0;
+    while (bucket < STAT_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+
+    lockStats();
+    StatHistogram *h = &histograms[timer];
+    h->count++;
+    h->total_ns += elapsed;
+    if (elapsed > h->max_ns) {
+        h->max_ns = elapsed;
+    }
+    h->buckets[bucket]++;
+    unlockStats();
+}
+
+// Add amount to counter
+void statsAdd(StatCounter counter, unsigned long long amount) {
+    lockStats();
+    counters[counter] += amount;
+    unlockStats();
+}
+
+// Upper bound (in microseconds) of the bucket holding the given percentile
+static double histogramPercentile(const StatHistogram *h, int percent) {
+    unsigned long long rank = (h->count * percent + 99) / 100;
+    unsigned long long seen = 0;
+    for (int b = 0; b < STAT_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            double upper = (double)(2ULL << b) / 1000.0;
+            double max = h->max_ns / 1000.0;
+            return upper < max ? upper : max;
+        }
+    }
+    return h->max_ns / 1000.0;
+}
+
+// Print every operation that ran, then the counters
+void printStats(FILE *out) {
+    StatHistogram snapshot[STAT_TIMER_COUNT];
+    unsigned long long totals[STAT_COUNTER_COUNT];
+    lockStats();
+    memcpy(snapshot, histograms, sizeof(snapshot));
+    memcpy(totals, counters, sizeof(totals));
+    unlockStats();
+
+    fprintf(out, "\n=== Operation Statistics ===\n");
+    if (!stats_enabled) {
+        fprintf(out, "Collection is off (start with --stats to turn it on).\n");
+        return;
+    }
+    fprintf(out, "%-22s %9s %12s %11s %11s %11s %11s\n",
+            "Operation", "Calls", "Total (ms)", "Mean (us)", "p50 (us)", "p99 (us)", "Max (us)");
+    fprintf(out, "================================================================================================\n");
+    int shown = 0;
+    for (int t = 0; t < STAT_TIMER_COUNT; t++) {
+        const StatHistogram *h = &snapshot[t];
+        if (h->count == 0) {
+            continue;
+        }
+        fprintf(out, "%-22s %9llu %12.3f %11.2f %11.2f %11.2f %11.2f\n",
+                timer_names[t], h->count, h->total_ns / 1e6, h->total_ns / 1e3 / h->count,
+                histogramPercentile(h, 50), histogramPercentile(h, 99), h->max_ns / 1e3);
+        shown++;
+    }
+    if (shown == 0) {
+        fprintf(out, "No operations recorded yet.\n");
+    }
+    fprintf(out, "(percentiles are the upper edge of a power-of-two histogram bucket)\n\n");
+    for (int c = 0; c < STAT_COUNTER_COUNT; c++) {
+        fprintf(out, "%-22s %llu\n", counter_names[c], totals[c]);
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+// Latency histogram buckets: bucket b counts calls of [2^b, 2^(b+1)) ns
+#define STAT_BUCKETS 40
+
+// Timed operations
+typedef enum {
+    STAT_LOAD,
+    STAT_SAVE,
+    STAT_BACKUP,
+    STAT_SNAPSHOT_LOAD,
+    STAT_SNAPSHOT_SAVE,
+    STAT_FIND_ROLL,
+    STAT_FIND_PHONE,
+    STAT_FIND_DEPARTMENT,
+    STAT_LINEAR_NAME,
+    STAT_LINEAR_PHONE,
+    STAT_LINEAR_ROLL,
+    STAT_LINEAR_DEPARTMENT,
+    STAT_BINARY_NAME,
+    STAT_BINARY_ROLL,
+    STAT_NAME_PREFIX,
+    STAT_PHONE_PREFIX,
+    STAT_ROLL_RANGE,
+    STAT_FUZZY_NAME,
+    STAT_SOUNDS_LIKE,
+    STAT_SORT,
+    STAT_DELETE,
+    STAT_COMPACT,
+    STAT_TIMER_COUNT
+} StatTimer;
+
+// Plain counters
+typedef enum {
+    STAT_REALLOCS,
+    STAT_REALLOC_BYTES,         // Size of the grown blocks
+    STAT_BYTES_READ,
+    STAT_BYTES_WRITTEN,
+    STAT_COUNTER_COUNT
+} StatCounter;
+
+// Collection is off unless this is set; every probe checks it first, so a
+// disabled probe costs one predictable branch
+extern int stats_enabled;
+
+// Start a timer: declares start, read only when collection is on
+#define STATS_START(start) unsigned long long start = stats_enabled ? statsClock() : 0
+// Record the time since start under timer
+#define STATS_STOP(timer, start) do { if (stats_enabled) statsRecord((timer), (start)); } while (0)
+// Add amount to a counter
+#define STATS_COUNT(counter, amount) do { if (stats_enabled) statsAdd((counter), (amount)); } while (0)
+// Count a successful reallocation to a block of bytes
+#define STATS_REALLOC(bytes) do { if (stats_enabled) { statsAdd(STAT_REALLOCS, 1); \
+                                                      statsAdd(STAT_REALLOC_BYTES, (bytes)); } } while (0)
+
+// Function declarations for statistics
+void enableStats(void);
+void resetStats(void);
+unsigned long long statsClock(void);
+void statsRecord(StatTimer timer, unsigned long long start);
+void statsAdd(StatCounter counter, unsigned long long amount);
+void printStats(FILE *out);
+
+#endif // STATS_H
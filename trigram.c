@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "trigram.h"
+
+// Set up an empty index (the list table is allocated lazily)
+void initializeTrigrams(TrigramIndex *index) {
+    initializePostingTable(index, TRIGRAM_COUNT);
+}
+
+// Free every posting list and the table itself
+void freeTrigrams(TrigramIndex *index) {
+    freePostingTable(index);
+}
+
+// Fold a character to its trigram symbol: 1-26 for letters, 0 otherwise
+static int trigramSymbol(char c) {
+    int lower = tolower((unsigned char)c);
+    return (lower >= 'a' && lower <= 'z') ? lower - 'a' + 1 : 0;
+}
+
+// Distinct trigram ids of a name, padded with two leading blanks and one
+// trailing blank so short names and word starts still produce trigrams.
+// grams must hold MAX_NAME_TRIGRAMS ids; returns how many were written.
+int nameTrigrams(const char *name, int *grams) {
+    int symbols[MAX_NAME_TRIGRAMS + 2];
+    int length = 0;
+    symbols[length++] = 0;
+    symbols[length++] = 0;
+    for (; *name && length < MAX_NAME_TRIGRAMS + 1; name++) {
+        symbols[length++] = trigramSymbol(*name);
+    }
+    symbols[length++] = 0;
+
+    // Insertion sort: a name has at most a few dozen trigrams
+    int count = 0;
+    for (int i = 0; i + 2 < length; i++) {
+        int gram = (symbols[i] * TRIGRAM_ALPHABET + symbols[i + 1]) * TRIGRAM_ALPHABET + symbols[i + 2];
+        int j = count++;
+        while (j > 0 && grams[j - 1] > gram) {
+            grams[j] = grams[j - 1];
+            j--;
+        }
+        grams[j] = gram;
+    }
+
+    int distinct = 0;
+    for (int i = 0; i < count; i++) {
+        if (distinct == 0 || grams[distinct - 1] != grams[i]) {
+            grams[distinct++] = grams[i];
+        }
+    }
+    return distinct;
+}
+
+// Index count names at once, for slots first..first+count-1. The name of
+// slot first + i is names[i].
+int bulkAddTrigrams(TrigramIndex *index, const char *const *names, int first, int count) {
+    return postingTableBulkAdd(index, nameTrigrams, names, first, count);
+}
+
+// Index slot under every trigram of name
+int addTrigrams(TrigramIndex *index, const char *name, int slot) {
+    int grams[MAX_NAME_TRIGRAMS];
+    int count = nameTrigrams(name, grams);
+    return postingTableAdd(index, grams, count, slot);
+}
+
+// Remove slot from every trigram of name
+void removeTrigrams(TrigramIndex *index, const char *name, int slot) {
+    int grams[MAX_NAME_TRIGRAMS];
+    int count = nameTrigrams(name, grams);
+    postingTableRemove(index, grams, count, slot);
+}
+
+// Case-insensitive Levenshtein distance between a and b, giving up as soon as
+// it must exceed bound. Returns bound + 1 in that case.
+int boundedEditDistance(const char *a, const char *b, int bound) {
+    int len_a = (int)strlen(a), len_b = (int)strlen(b);
+    if (abs(len_a - len_b) > bound) {
+        return bound + 1;
+    }
+    if (len_b > MAX_NAME_TRIGRAMS) {
+        len_b = MAX_NAME_TRIGRAMS;
+    }
+
+    int previous[MAX_NAME_TRIGRAMS + 1], current[MAX_NAME_TRIGRAMS + 1];
+    for (int j = 0; j <= len_b; j++) {
+        previous[j] = j;
+    }
+    for (int i = 1; i <= len_a; i++) {
+        int row_min = current[0] = i;
+        int ca = tolower((unsigned char)a[i - 1]);
+        for (int j = 1; j <= len_b; j++) {
+            int cost = ca == tolower((unsigned char)b[j - 1]) ? 0 : 1;
+            int best = previous[j - 1] + cost;
+            if (previous[j] + 1 < best) {
+                best = previous[j] + 1;
+            }
+            if (current[j - 1] + 1 < best) {
+                best = current[j - 1] + 1;
+            }
+            current[j] = best;
+            if (best < row_min) {
+                row_min = best;
+            }
+        }
+        if (row_min > bound) {
+            return bound + 1; // Every path through this row is already too long
+        }
+        memcpy(previous, current, (len_b + 1) * sizeof(int));
+    }
+    return previous[len_b] <= bound ? previous[len_b] : bound + 1;
+}
@@ -0,0 +1,24 @@
+#ifndef TRIGRAM_H
+#define TRIGRAM_H
+
+#include "posting.h"
+
+// Names are folded to 27 symbols (a-z and "anything else") before slicing
+// into trigrams, so every trigram has a slot in a direct-indexed table
+#define TRIGRAM_ALPHABET 27
+#define TRIGRAM_COUNT (TRIGRAM_ALPHABET * TRIGRAM_ALPHABET * TRIGRAM_ALPHABET)
+#define MAX_NAME_TRIGRAMS MAX_POSTING_KEYS
+
+// Inverted index: trigram -> slots of the names containing it
+typedef PostingTable TrigramIndex;
+
+// Function declarations for the trigram index
+void initializeTrigrams(TrigramIndex *index);
+void freeTrigrams(TrigramIndex *index);
+int nameTrigrams(const char *name, int *grams);
+int addTrigrams(TrigramIndex *index, const char *name, int slot);
+int bulkAddTrigrams(TrigramIndex *index, const char *const *names, int first, int count);
+void removeTrigrams(TrigramIndex *index, const char *name, int slot);
+int boundedEditDistance(const char *a, const char *b, int bound);
+
+#endif // TRIGRAM_H
@@ -0,0 +1,220 @@
+#include <string.h>
+#include "validate.h"
+
+// Batch validators for bulk ingestion. Each record gets the same verdict as
+// validateName && validatePhone && validateEmail, but the SIMD versions scan
+// a whole field per instruction instead of one ctype call per character.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+typedef int (*ContactValidator)(const Contact *contact);
+
+// Scalar fallback: the per-field validators used by the interactive menus
+static int validateContactScalar(const Contact *contact) {
+    return validateName(contact->name) &&
+           validatePhone(contact->phone) &&
+           validateEmail(contact->email);
+}
+
+#ifdef HAVE_X86_SIMD
+// 128 bits of per-byte flags for fields up to 128 bytes long
+typedef struct {
+    unsigned long long lo;
+    unsigned long long hi;
+} ByteMask;
+
+// Keep only the flags for bytes before position len
+static ByteMask maskBefore(ByteMask mask, int len) {
+    if (len < 64) {
+        mask.lo &= (1ULL << len) - 1;
+        mask.hi = 0;
+    } else if (len < 128) {
+        mask.hi &= (1ULL << (len - 64)) - 1;
+    }
+    return mask;
+}
+
+// Position of the first set flag (mask must be non-zero)
+static int firstBit(ByteMask mask) {
+    return mask.lo ? __builtin_ctzll(mask.lo) : 64 + __builtin_ctzll(mask.hi);
+}
+
+// Position of the last set flag (mask must be non-zero)
+static int lastBit(ByteMask mask) {
+    return mask.hi ? 127 - __builtin_clzll(mask.hi) : 63 - __builtin_clzll(mask.lo);
+}
+
+// Apply the phone, name and email rules to precomputed masks
+static int phoneVerdict(int len, unsigned int bad) {
+    return len >= 10 && len < MAX_PHONE_LEN && (bad & ((1u << len) - 1)) == 0;
+}
+
+static int nameVerdict(int len, unsigned long long bad) {
+    return len > 0 && len < MAX_NAME_LEN && (bad & ((1ULL << len) - 1)) == 0;
+}
+
+static int emailVerdict(int len, ByteMask at, ByteMask dot) {
+    if (len == 0 || len >= MAX_EMAIL_LEN) {
+        return 0;
+    }
+    at = maskBefore(at, len);
+    dot = maskBefore(dot, len);
+    if ((at.lo | at.hi) == 0 || (dot.lo | dot.hi) == 0) {
+        return 0;
+    }
+    return firstBit(at) < lastBit(dot);
+}
+
+// Phone check shared by both x86 paths (the field fits one 16-byte vector)
+__attribute__((target("sse2")))
+static int validatePhoneSSE2(const char *phone) {
+    unsigned char buffer[16] __attribute__((aligned(16)));
+    memcpy(buffer, phone, MAX_PHONE_LEN);
+    buffer[15] = '\0';
+
+    __m128i v = _mm_load_si128((const __m128i *)buffer);
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    __m128i punct = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('+')),
+                                              _mm_cmpeq_epi8(v, _mm_set1_epi8('-'))),
+                                 _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('(')),
+                                                           _mm_cmpeq_epi8(v, _mm_set1_epi8(')'))),
+                                              _mm_cmpeq_epi8(v, _mm_set1_epi8(' '))));
+    unsigned int zero = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    unsigned int good = (unsigned int)_mm_movemask_epi8(_mm_or_si128(digit, punct));
+    return phoneVerdict(__builtin_ctz(zero), ~good & 0xFFFFu);
+}
+
+// SSE2: 16 bytes per step
+__attribute__((target("sse2")))
+static int validateContactSSE2(const Contact *contact) {
+    unsigned char name[64] __attribute__((aligned(16)));
+    memcpy(name, contact->name, MAX_NAME_LEN);
+    memset(name + MAX_NAME_LEN, 0, sizeof(name) - MAX_NAME_LEN);
+
+    unsigned long long zero = 0, good = 0;
+    for (int b = 0; b < 4; b++) {
+        __m128i v = _mm_load_si128((const __m128i *)(name + 16 * b));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                       _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        zero |= (unsigned long long)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) << (16 * b);
+        good |= (unsigned long long)(unsigned int)_mm_movemask_epi8(_mm_or_si128(letter, space)) << (16 * b);
+    }
+    if (!nameVerdict(__builtin_ctzll(zero), ~good) || !validatePhoneSSE2(contact->phone)) {
+        return 0;
+    }
+
+    unsigned char email[128] __attribute__((aligned(16)));
+    memcpy(email, contact->email, MAX_EMAIL_LEN);
+    memset(email + MAX_EMAIL_LEN, 0, sizeof(email) - MAX_EMAIL_LEN);
+
+    ByteMask nul = {0, 0}, at = {0, 0}, dot = {0, 0};
+    for (int b = 0; b < 8; b++) {
+        __m128i v = _mm_load_si128((const __m128i *)(email + 16 * b));
+        unsigned long long z = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+        unsigned long long a = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('@')));
+        unsigned long long d = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')));
+        int shift = 16 * (b & 3);
+        if (b < 4) {
+            nul.lo |= z << shift;
+            at.lo |= a << shift;
+            dot.lo |= d << shift;
+        } else {
+            nul.hi |= z << shift;
+            at.hi |= a << shift;
+            dot.hi |= d << shift;
+        }
+    }
+    return emailVerdict(firstBit(nul), at, dot);
+}
+
+// AVX2: 32 bytes per step
+__attribute__((target("avx2")))
+static int validateContactAVX2(const Contact *contact) {
+    unsigned char name[64] __attribute__((aligned(32)));
+    memcpy(name, contact->name, MAX_NAME_LEN);
+    memset(name + MAX_NAME_LEN, 0, sizeof(name) - MAX_NAME_LEN);
+
+    unsigned long long zero = 0, good = 0;
+    for (int b = 0; b < 2; b++) {
+        __m256i v = _mm256_load_si256((const __m256i *)(name + 32 * b));
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i space = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+        zero |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256())) << (32 * b);
+        good |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(_mm256_or_si256(letter, space)) << (32 * b);
+    }
+    if (!nameVerdict(__builtin_ctzll(zero), ~good) || !validatePhoneSSE2(contact->phone)) {
+        return 0;
+    }
+
+    unsigned char email[128] __attribute__((aligned(32)));
+    memcpy(email, contact->email, MAX_EMAIL_LEN);
+    memset(email + MAX_EMAIL_LEN, 0, sizeof(email) - MAX_EMAIL_LEN);
+
+    ByteMask nul = {0, 0}, at = {0, 0}, dot = {0, 0};
+    for (int b = 0; b < 4; b++) {
+        __m256i v = _mm256_load_si256((const __m256i *)(email + 32 * b));
+        unsigned long long z = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+        unsigned long long a = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('@')));
+        unsigned long long d = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')));
+        int shift = 32 * (b & 1);
+        if (b < 2) {
+            nul.lo |= z << shift;
+            at.lo |= a << shift;
+            dot.lo |= d << shift;
+        } else {
+            nul.hi |= z << shift;
+            at.hi |= a << shift;
+            dot.hi |= d << shift;
+        }
+    }
+    return emailVerdict(firstBit(nul), at, dot);
+}
+#endif
+
+// Pick the widest implementation this CPU supports
+static ContactValidator selectValidator(const char **name) {
+#ifdef HAVE_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return validateContactAVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        *name = "sse2";
+        return validateContactSSE2;
+    }
+#endif
+    *name = "scalar";
+    return validateContactScalar;
+}
+
+// Validate name, phone and email of count records. Bit i of bitmap is set
+// when record i passes; returns the number of records that passed.
+int validateContactBatch(const Contact *contacts, int count, unsigned long long *bitmap) {
+    const char *name;
+    ContactValidator validate = selectValidator(&name);
+    int valid = 0;
+
+    memset(bitmap, 0, VALIDATE_BITMAP_WORDS(count) * sizeof(unsigned long long));
+    for (int i = 0; i < count; i++) {
+        if (validate(&contacts[i])) {
+            bitmap[i / 64] |= 1ULL << (i % 64);
+            valid++;
+        }
+    }
+    return valid;
+}
+
+// Name of the implementation validateContactBatch dispatches to
+const char *validatorImplementation(void) {
+    const char *name;
+    selectValidator(&name);
+    return name;
+}
@@ -0,0 +1,13 @@
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include "contact.h"
+
+// Number of 64-bit words needed for a result bitmap covering count records
+#define VALIDATE_BITMAP_WORDS(count) (((count) + 63) / 64)
+
+// Function declarations for batch validation
+int validateContactBatch(const Contact *contacts, int count, unsigned long long *bitmap);
+const char *validatorImplementation(void);
+
+#endif // VALIDATE_H